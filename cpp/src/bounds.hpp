@@ -0,0 +1,168 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
+#include <OSD_Parallel.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "shared.hpp"
+#include "utils.hpp"
+
+enum class BoundsKind {
+    /// @brief assembly node without a shape of its own, bounds of its children
+    Group,
+    Shape,
+    Solid,
+    Face,
+};
+
+struct BoundsHierarchy {
+    /// @brief one record of `stride` floats per node in depth-first order:
+    /// kind, parent record (-1 for the root), number of descendant records, sub-shape index (TopExp::MapShapes
+    /// order within the owning shape, -1 for groups and shapes), AABB min xyz, max xyz and, when oriented,
+    /// OBB center xyz followed by its x, y and z axes scaled by the half sizes
+    Float32Array nodes;
+    int stride;
+};
+
+/// @brief Builds the packed bounds hierarchy: shape -> solids -> faces, faces outside any solid hang directly
+/// below the shape. Faces are bounded in parallel from their triangulation when one exists, and parent AABBs
+/// are the union of their children. An empty box is written as min = +inf, max = -inf.
+class BoundsBuilder {
+    bool oriented;
+    std::vector<float> records;
+
+    int begin(BoundsKind kind, int parent, int subShapeIndex)
+    {
+        int node = static_cast<int>(records.size()) / stride();
+        records.insert(records.end(), { static_cast<float>(kind), static_cast<float>(parent), 0,
+                                          static_cast<float>(subShapeIndex) });
+        records.resize(records.size() + stride() - 4, 0);
+        return node;
+    }
+
+    void end(int node, const Bnd_Box& box, const Bnd_OBB& obb)
+    {
+        float* record = records.data() + node * stride();
+        record[2] = static_cast<float>(records.size() / stride() - node - 1);
+        if (box.IsVoid()) {
+            std::fill(record + 4, record + 7, std::numeric_limits<float>::infinity());
+            std::fill(record + 7, record + 10, -std::numeric_limits<float>::infinity());
+        } else {
+            double xmin, ymin, zmin, xmax, ymax, zmax;
+            box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+            double values[] = { xmin, ymin, zmin, xmax, ymax, zmax };
+            std::copy(values, values + 6, record + 4);
+        }
+
+        if (oriented && !obb.IsVoid()) {
+            gp_XYZ center = obb.Center();
+            gp_XYZ x = obb.XDirection() * obb.XHSize();
+            gp_XYZ y = obb.YDirection() * obb.YHSize();
+            gp_XYZ z = obb.ZDirection() * obb.ZHSize();
+            double values[] = { center.X(), center.Y(), center.Z(), x.X(), x.Y(), x.Z(), y.X(), y.Y(), y.Z(), z.X(),
+                z.Y(), z.Z() };
+            std::copy(values, values + 12, record + 10);
+        }
+    }
+
+    void addOBB(const TopoDS_Shape& shape, Bnd_OBB& obb) const
+    {
+        if (oriented) {
+            BRepBndLib::AddOBB(shape, obb, true, false, true);
+        }
+    }
+
+    void addFace(int parent, int index, const std::vector<Bnd_Box>& boxes, const std::vector<Bnd_OBB>& obbs)
+    {
+        int node = begin(BoundsKind::Face, parent, index);
+        end(node, boxes[index], oriented ? obbs[index] : Bnd_OBB());
+    }
+
+public:
+    explicit BoundsBuilder(bool oriented)
+        : oriented(oriented)
+    {
+    }
+
+    int stride() const
+    {
+        return oriented ? 22 : 10;
+    }
+
+    /// @brief adds the shape with its solids and faces below parent and returns the shape bounds
+    Bnd_Box addShape(const TopoDS_Shape& shape, int parent, Bnd_OBB& obb)
+    {
+        int node = begin(BoundsKind::Shape, parent, -1);
+        TopTools_IndexedMapOfShape faceMap, solidMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        TopExp::MapShapes(shape, TopAbs_SOLID, solidMap);
+
+        std::vector<Bnd_Box> faceBoxes(faceMap.Extent());
+        std::vector<Bnd_OBB> faceObbs(oriented ? faceMap.Extent() : 0);
+        OSD_Parallel::For(0, faceMap.Extent(), [&](int i) {
+            BRepBndLib::Add(faceMap(i + 1), faceBoxes[i], true);
+            if (oriented) {
+                addOBB(faceMap(i + 1), faceObbs[i]);
+            }
+        });
+
+        Bnd_Box box;
+        std::vector<bool> inSolid(faceMap.Extent(), false);
+        for (int s = 1; s <= solidMap.Extent(); s++) {
+            int solidNode = begin(BoundsKind::Solid, node, s - 1);
+            TopTools_IndexedMapOfShape solidFaces;
+            TopExp::MapShapes(solidMap(s), TopAbs_FACE, solidFaces);
+            Bnd_Box solidBox;
+            for (int f = 1; f <= solidFaces.Extent(); f++) {
+                int index = faceMap.FindIndex(solidFaces(f)) - 1;
+                inSolid[index] = true;
+                solidBox.Add(faceBoxes[index]);
+                addFace(solidNode, index, faceBoxes, faceObbs);
+            }
+            Bnd_OBB solidObb;
+            addOBB(solidMap(s), solidObb);
+            end(solidNode, solidBox, solidObb);
+            box.Add(solidBox);
+        }
+        for (int i = 0; i < faceMap.Extent(); i++) {
+            if (!inSolid[i]) {
+                box.Add(faceBoxes[i]);
+                addFace(node, i, faceBoxes, faceObbs);
+            }
+        }
+
+        if (faceMap.IsEmpty()) {
+            BRepBndLib::Add(shape, box, true);
+        }
+        addOBB(shape, obb);
+        end(node, box, obb);
+        return box;
+    }
+
+    /// @brief starts a group record; children are added with the returned record as parent
+    int beginGroup(int parent)
+    {
+        return begin(BoundsKind::Group, parent, -1);
+    }
+
+    void endGroup(int node, const Bnd_Box& box, const Bnd_OBB& obb)
+    {
+        end(node, box, obb);
+    }
+
+    BoundsHierarchy result() const
+    {
+        return BoundsHierarchy { toTypedArray<Float32Array>(records), stride() };
+    }
+};
@@ -6,13 +6,16 @@
 
 #include <BRepBuilderAPI_MakeSolid.hxx>
 #include <BRepBuilderAPI_Sewing.hxx>
-#include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
 #include <BRep_Builder.hxx>
+#include <BinTools.hxx>
+#include <Bnd_Box.hxx>
 #include <IGESCAFControl_Reader.hxx>
+#include <IGESCAFControl_Writer.hxx>
 #include <IGESControl_Writer.hxx>
 #include <Quantity_Color.hxx>
 #include <STEPCAFControl_Reader.hxx>
+#include <STEPCAFControl_Writer.hxx>
 #include <STEPControl_Writer.hxx>
 #include <StlAPI_Reader.hxx>
 #include <StlAPI_Writer.hxx>
@@ -20,12 +23,22 @@
 #include <TDF_Label.hxx>
 #include <TDataStd_Name.hxx>
 #include <TDocStd_Document.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shape.hxx>
 #include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DataMapOfShapeLabel.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XCAFDoc_ShapeTool.hxx>
 
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+#include "bounds.hpp"
+#include "mesher.hpp"
 #include "shared.hpp"
 #include "utils.hpp"
 
@@ -37,9 +50,134 @@ public:
     {
         setg((char*)v.data(), (char*)v.data(), (char*)(v.data() + v.size()));
     }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        char* base = dir == std::ios_base::beg ? eback() : (dir == std::ios_base::cur ? gptr() : egptr());
+        char* target = base + off;
+        if (!(which & std::ios_base::in) || target < eback() || target > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), target, egptr());
+        return pos_type(target - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
 };
 
+/// @brief A growable output buffer. Writers stream straight into it and the bytes are handed to JS once,
+/// avoiding the ostringstream -> std::string -> JS string copies.
+class ByteBuffer : public std::streambuf {
+private:
+    std::vector<uint8_t> bytes;
+
+    void reserve(size_t capacity)
+    {
+        size_t used = size();
+        bytes.resize(capacity);
+        char* begin = reinterpret_cast<char*>(bytes.data());
+        setp(begin, begin + capacity);
+        advance(used);
+    }
+
+    /// @brief pbump takes an int, larger offsets are applied in steps
+    void advance(size_t count)
+    {
+        while (count > 0) {
+            int step = static_cast<int>(std::min<size_t>(count, std::numeric_limits<int>::max()));
+            pbump(step);
+            count -= step;
+        }
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        reserve(std::max<size_t>(bytes.size() * 2, 64));
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        if (epptr() - pptr() < n) {
+            reserve(std::max<size_t>(bytes.size() * 2, size() + n));
+        }
+        std::memcpy(pptr(), s, n);
+        advance(n);
+        return n;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if (off == 0 && dir == std::ios_base::cur && (which & std::ios_base::out)) {
+            return pos_type(off_type(size()));
+        }
+        return pos_type(off_type(-1));
+    }
+
+public:
+    ByteBuffer(size_t capacity = 1 << 16)
+    {
+        reserve(capacity);
+    }
+
+    size_t size() const
+    {
+        return pptr() - pbase();
+    }
+
+    const uint8_t* data() const
+    {
+        return bytes.data();
+    }
+
+    Uint8Array toUint8Array() const
+    {
+        return Uint8Array(val(typed_memory_view(size(), data())).call<val>("slice"));
+    }
+};
+
+/// @brief 64-bit content hash used to key the import cache. Words are folded 8 bytes at a time
+/// and finished with the splitmix64 avalanche, which is fast enough to run on every opened file.
+static uint64_t contentHash64(const uint8_t* data, size_t size)
+{
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL ^ (size * 0x9e3779b97f4a7c15ULL);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ data[i]) * prime;
+    }
+
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+static std::string toHex(uint64_t value)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return std::string(buffer, 16);
+}
+
 EMSCRIPTEN_DECLARE_VAL_TYPE(ShapeNodeArray)
+EMSCRIPTEN_DECLARE_VAL_TYPE(ExportNodeArray)
+EMSCRIPTEN_DECLARE_VAL_TYPE(Uint8ArrayArray)
 
 struct ShapeNode {
     std::optional<TopoDS_Shape> shape;
@@ -51,83 +189,208 @@ struct ShapeNode {
     {
         return ShapeNodeArray(val::array(children));
     }
+
+    /// @brief packed bounds of the node tree: groups for nodes without a shape, shape -> solids -> faces below
+    /// nodes with one
+    BoundsHierarchy getBounds(bool oriented) const
+    {
+        BoundsBuilder builder(oriented);
+        Bnd_OBB obb;
+        addBounds(builder, -1, obb);
+        return builder.result();
+    }
+
+    Bnd_Box addBounds(BoundsBuilder& builder, int parent, Bnd_OBB& obb) const
+    {
+        if (shape.has_value() && children.empty()) {
+            return builder.addShape(shape.value(), parent, obb);
+        }
+
+        int node = builder.beginGroup(parent);
+        Bnd_Box box;
+        if (shape.has_value()) {
+            box.Add(builder.addShape(shape.value(), node, obb));
+        }
+        for (const auto& child : children) {
+            Bnd_OBB childObb;
+            box.Add(child.addBounds(builder, node, childObb));
+            obb.Add(childObb);
+        }
+        builder.endGroup(node, box, obb);
+        return box;
+    }
 };
 
-// copy from https://github.com/kovacsv/occt-import-js/blob/main/occt-import-js/src/importer-xcaf.cpp
-std::string getLabelNameNoRef(const TDF_Label& label)
-{
-    Handle(TDataStd_Name) nameAttribute = new TDataStd_Name();
-    if (!label.FindAttribute(nameAttribute->GetID(), nameAttribute)) {
-        return std::string();
+struct ImportStatistics {
+    /// @brief number of XCAF labels visited while building the lookup maps
+    int labelCount;
+    /// @brief shape -> label lookups answered from the map
+    int shapeLookups;
+    /// @brief shape lookups that did not resolve to any label
+    int shapeMisses;
+    /// @brief label -> name lookups, and how many of them required a TDataStd_Name conversion
+    int nameLookups;
+    int nameConversions;
+    /// @brief label -> color lookups, and how many of them queried the color tool
+    int colorLookups;
+    int colorQueries;
+};
+
+/// @brief Caches the XCAF attributes of a document. All shape labels are collected in one traversal of the
+/// label tree, names and colors are resolved lazily once per label (following references) and then reused,
+/// so heavily instanced assemblies no longer repeat XCAFDoc_ShapeTool::Search for every sub-shape.
+class XcafAttributeCache {
+private:
+    Handle(XCAFDoc_ShapeTool) shapeTool;
+    Handle(XCAFDoc_ColorTool) colorTool;
+    XCAFDoc_DataMapOfShapeLabel shapeLabels;
+    std::unordered_map<TDF_Label, std::string> labelNames;
+    std::unordered_map<TDF_Label, std::optional<std::string>> labelColors;
+
+    void bindShapeLabels(const std::vector<TDF_Label>& labels)
+    {
+        TopoDS_Shape shape;
+        for (const auto& label : labels) {
+            if (!XCAFDoc_ShapeTool::GetShape(label, shape) || shape.IsNull()) {
+                continue;
+            }
+            if (!shapeLabels.IsBound(shape)) {
+                shapeLabels.Bind(shape, label);
+            }
+        }
     }
 
-    Standard_Integer utf8NameLength = nameAttribute->Get().LengthOfCString();
-    char* nameBuf = new char[utf8NameLength + 1];
-    nameAttribute->Get().ToUTF8CString(nameBuf);
-    std::string name(nameBuf, utf8NameLength);
-    delete[] nameBuf;
-    return name;
-}
+    // copy from https://github.com/kovacsv/occt-import-js/blob/main/occt-import-js/src/importer-xcaf.cpp
+    std::string labelNameNoRef(const TDF_Label& label)
+    {
+        Handle(TDataStd_Name) nameAttribute;
+        if (!label.FindAttribute(TDataStd_Name::GetID(), nameAttribute)) {
+            return std::string();
+        }
 
-std::string getLabelName(const TDF_Label& label, const Handle(XCAFDoc_ShapeTool) & shapeTool)
-{
-    if (XCAFDoc_ShapeTool::IsReference(label)) {
-        TDF_Label referredShapeLabel;
-        shapeTool->GetReferredShape(label, referredShapeLabel);
-        return getLabelName(referredShapeLabel, shapeTool);
+        statistics.nameConversions++;
+        Standard_Integer utf8NameLength = nameAttribute->Get().LengthOfCString();
+        std::string name(utf8NameLength, '\0');
+        char* nameBuf = name.data();
+        nameAttribute->Get().ToUTF8CString(nameBuf);
+        return name;
     }
-    return getLabelNameNoRef(label);
-}
 
-std::string getShapeName(const TopoDS_Shape& shape, const Handle(XCAFDoc_ShapeTool) & shapeTool)
-{
-    TDF_Label shapeLabel;
-    if (!shapeTool->Search(shape, shapeLabel)) {
-        return std::string();
+    std::optional<std::string> labelColorNoRef(const TDF_Label& label)
+    {
+        static const std::vector<XCAFDoc_ColorType> colorTypes = { XCAFDoc_ColorSurf, XCAFDoc_ColorCurv,
+            XCAFDoc_ColorGen };
+
+        statistics.colorQueries++;
+        Quantity_Color qColor;
+        for (XCAFDoc_ColorType colorType : colorTypes) {
+            if (colorTool->GetColor(label, colorType, qColor)) {
+                return std::string(Quantity_Color::ColorToHex(qColor).ToCString());
+            }
+        }
+
+        return std::nullopt;
     }
-    return getLabelName(shapeLabel, shapeTool);
-}
 
-bool getLabelColorNoRef(const TDF_Label& label, const Handle(XCAFDoc_ColorTool) & colorTool, std::string& color)
-{
-    static const std::vector<XCAFDoc_ColorType> colorTypes = { XCAFDoc_ColorSurf, XCAFDoc_ColorCurv, XCAFDoc_ColorGen };
+public:
+    ImportStatistics statistics;
 
-    Quantity_Color qColor;
-    for (XCAFDoc_ColorType colorType : colorTypes) {
-        if (colorTool->GetColor(label, colorType, qColor)) {
-            color = std::string(Quantity_Color::ColorToHex(qColor).ToCString());
-            return true;
+    XcafAttributeCache(const Handle(XCAFDoc_ShapeTool) & shapeTool, const Handle(XCAFDoc_ColorTool) & colorTool)
+        : shapeTool(shapeTool)
+        , colorTool(colorTool)
+        , statistics()
+    {
+        // Search() prefers top-level shapes, then assembly components, then sub-shapes. The labels are
+        // collected in a single pass and bound in that order so the map answers the same way.
+        std::vector<TDF_Label> topLevels, components, subShapes;
+        for (TDF_ChildIterator it(shapeTool->Label(), true); it.More(); it.Next()) {
+            TDF_Label label = it.Value();
+            statistics.labelCount++;
+            if (shapeTool->IsTopLevel(label)) {
+                topLevels.push_back(label);
+            } else if (XCAFDoc_ShapeTool::IsComponent(label)) {
+                components.push_back(label);
+            } else if (XCAFDoc_ShapeTool::IsSubShape(label)) {
+                subShapes.push_back(label);
+            }
         }
+
+        bindShapeLabels(topLevels);
+        bindShapeLabels(components);
+        bindShapeLabels(subShapes);
     }
 
-    return false;
-}
+    const Handle(XCAFDoc_ShapeTool) & getShapeTool() const
+    {
+        return shapeTool;
+    }
 
-bool getLabelColor(const TDF_Label& label, const Handle(XCAFDoc_ShapeTool) & shapeTool,
-    const Handle(XCAFDoc_ColorTool) & colorTool, std::string& color)
-{
-    if (getLabelColorNoRef(label, colorTool, color)) {
-        return true;
+    std::optional<TDF_Label> findLabel(const TopoDS_Shape& shape)
+    {
+        statistics.shapeLookups++;
+        if (auto label = shapeLabels.Seek(shape)) {
+            return *label;
+        }
+
+        // same fallback as Search(findWithoutLoc = true)
+        if (!shape.Location().IsIdentity()) {
+            if (auto label = shapeLabels.Seek(shape.Located(TopLoc_Location()))) {
+                return *label;
+            }
+        }
+
+        statistics.shapeMisses++;
+        return std::nullopt;
     }
 
-    if (XCAFDoc_ShapeTool::IsReference(label)) {
-        TDF_Label referredShape;
-        shapeTool->GetReferredShape(label, referredShape);
-        return getLabelColor(referredShape, shapeTool, colorTool, color);
+    std::string labelName(const TDF_Label& label)
+    {
+        statistics.nameLookups++;
+        auto it = labelNames.find(label);
+        if (it != labelNames.end()) {
+            return it->second;
+        }
+
+        std::string name;
+        TDF_Label referredShapeLabel;
+        if (XCAFDoc_ShapeTool::GetReferredShape(label, referredShapeLabel)) {
+            name = labelName(referredShapeLabel);
+        } else {
+            name = labelNameNoRef(label);
+        }
+        labelNames.emplace(label, name);
+        return name;
     }
 
-    return false;
-}
+    std::optional<std::string> labelColor(const TDF_Label& label)
+    {
+        statistics.colorLookups++;
+        auto it = labelColors.find(label);
+        if (it != labelColors.end()) {
+            return it->second;
+        }
 
-bool getShapeColor(const TopoDS_Shape& shape, const Handle(XCAFDoc_ShapeTool) & shapeTool,
-    const Handle(XCAFDoc_ColorTool) & colorTool, std::string& color)
-{
-    TDF_Label shapeLabel;
-    if (!shapeTool->Search(shape, shapeLabel)) {
-        return false;
+        auto color = labelColorNoRef(label);
+        TDF_Label referredShapeLabel;
+        if (!color.has_value() && XCAFDoc_ShapeTool::GetReferredShape(label, referredShapeLabel)) {
+            color = labelColor(referredShapeLabel);
+        }
+        labelColors.emplace(label, color);
+        return color;
     }
-    return getLabelColor(shapeLabel, shapeTool, colorTool, color);
-}
+
+    std::string shapeName(const TopoDS_Shape& shape)
+    {
+        auto label = findLabel(shape);
+        return label.has_value() ? labelName(label.value()) : std::string();
+    }
+
+    std::optional<std::string> shapeColor(const TopoDS_Shape& shape)
+    {
+        auto label = findLabel(shape);
+        return label.has_value() ? labelColor(label.value()) : std::nullopt;
+    }
+};
 
 bool isFreeShape(const TDF_Label& label, const Handle(XCAFDoc_ShapeTool) & shapeTool)
 {
@@ -171,84 +434,81 @@ bool isMeshNode(const TDF_Label& label, const Handle(XCAFDoc_ShapeTool) & shapeT
     return false;
 }
 
-ShapeNode initLabelNode(const TDF_Label label, const Handle(XCAFDoc_ShapeTool) shapeTool,
-    const Handle(XCAFDoc_ColorTool) colorTool)
+ShapeNode initLabelNode(const TDF_Label label, XcafAttributeCache& cache)
 {
-    std::string color;
-    getLabelColor(label, shapeTool, colorTool, color);
-
     ShapeNode node = {
         .shape = std::nullopt,
-        .color = color,
+        .color = cache.labelColor(label).value_or(std::string()),
         .children = {},
-        .name = getLabelName(label, shapeTool),
+        .name = cache.labelName(label),
     };
 
     return node;
 }
 
-ShapeNode initShapeNode(const TopoDS_Shape& shape, const Handle(XCAFDoc_ShapeTool) & shapeTool,
-    const Handle(XCAFDoc_ColorTool) & colorTool)
+ShapeNode initShapeNode(const TopoDS_Shape& shape, XcafAttributeCache& cache)
 {
-    std::string color;
-    getShapeColor(shape, shapeTool, colorTool, color);
-    ShapeNode childShapeNode = { .shape = shape, .color = color, .children = {}, .name = getShapeName(shape, shapeTool) };
+    auto label = cache.findLabel(shape);
+    std::string color, name;
+    if (label.has_value()) {
+        color = cache.labelColor(label.value()).value_or(std::string());
+        name = cache.labelName(label.value());
+    }
+    ShapeNode childShapeNode = { .shape = shape, .color = color, .children = {}, .name = name };
     return childShapeNode;
 }
 
-ShapeNode initGroupNode(const TopoDS_Shape& shape, const Handle_XCAFDoc_ShapeTool& shapeTool)
+ShapeNode initGroupNode(const TopoDS_Shape& shape, XcafAttributeCache& cache)
 {
-    ShapeNode groupNode = {
-        .shape = std::nullopt, .color = std::nullopt, .children = {}, .name = getShapeName(shape, shapeTool)
-    };
+    ShapeNode groupNode = { .shape = std::nullopt, .color = std::nullopt, .children = {}, .name = cache.shapeName(shape) };
 
     return groupNode;
 }
 
-ShapeNode parseShape(TopoDS_Shape& shape, const Handle_XCAFDoc_ShapeTool& shapeTool,
-    const Handle_XCAFDoc_ColorTool& colorTool)
+ShapeNode parseShape(TopoDS_Shape& shape, XcafAttributeCache& cache)
 {
     if (shape.ShapeType() == TopAbs_COMPOUND || shape.ShapeType() == TopAbs_COMPSOLID) {
-        auto node = initGroupNode(shape, shapeTool);
+        auto node = initGroupNode(shape, cache);
         TopoDS_Iterator iterator(shape);
         while (iterator.More()) {
             auto subShape = iterator.Value();
-            node.children.push_back(parseShape(subShape, shapeTool, colorTool));
+            node.children.push_back(parseShape(subShape, cache));
             iterator.Next();
         }
         return node;
     }
-    return initShapeNode(shape, shapeTool, colorTool);
+    return initShapeNode(shape, cache);
 }
 
-ShapeNode parseLabelToNode(const TDF_Label& label, const Handle(XCAFDoc_ShapeTool) & shapeTool,
-    const Handle(XCAFDoc_ColorTool) & colorTool)
+ShapeNode parseLabelToNode(const TDF_Label& label, XcafAttributeCache& cache)
 {
+    const auto& shapeTool = cache.getShapeTool();
     if (isMeshNode(label, shapeTool)) {
         auto shape = shapeTool->GetShape(label);
-        return parseShape(shape, shapeTool, colorTool);
+        return parseShape(shape, cache);
     }
 
-    auto node = initLabelNode(label, shapeTool, colorTool);
+    auto node = initLabelNode(label, cache);
     for (TDF_ChildIterator it(label); it.More(); it.Next()) {
         auto childLabel = it.Value();
         if (isFreeShape(childLabel, shapeTool)) {
-            auto childNode = parseLabelToNode(childLabel, shapeTool, colorTool);
+            auto childNode = parseLabelToNode(childLabel, cache);
             node.children.push_back(childNode);
         }
     }
     return node;
 }
 
-ShapeNode parseRootLabelToNode(const Handle(XCAFDoc_ShapeTool) & shapeTool, const Handle(XCAFDoc_ColorTool) & colorTool)
+ShapeNode parseRootLabelToNode(XcafAttributeCache& cache)
 {
+    const auto& shapeTool = cache.getShapeTool();
     auto label = shapeTool->Label();
 
-    ShapeNode node = initLabelNode(label, shapeTool, colorTool);
+    ShapeNode node = initLabelNode(label, cache);
     for (TDF_ChildIterator it(label); it.More(); it.Next()) {
         auto childLabel = it.Value();
         if (isFreeShape(childLabel, shapeTool)) {
-            auto childNode = parseLabelToNode(childLabel, shapeTool, colorTool);
+            auto childNode = parseLabelToNode(childLabel, cache);
             node.children.push_back(childNode);
         }
     }
@@ -256,17 +516,675 @@ ShapeNode parseRootLabelToNode(const Handle(XCAFDoc_ShapeTool) & shapeTool, cons
     return node;
 }
 
-static ShapeNode parseNodeFromDocument(Handle(TDocStd_Document) document)
+static ShapeNode parseNodeFromDocument(Handle(TDocStd_Document) document, ImportStatistics& statistics)
 {
     TDF_Label mainLabel = document->Main();
     Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(mainLabel);
     Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(mainLabel);
 
-    return parseRootLabelToNode(shapeTool, colorTool);
+    XcafAttributeCache cache(shapeTool, colorTool);
+    auto node = parseRootLabelToNode(cache);
+    statistics = cache.statistics;
+    return node;
+}
+
+struct ExportNode {
+    TopoDS_Shape shape;
+    std::string name;
+    /// @brief hex color such as "#FF0000", empty if the node has no color
+    std::string color;
+    /// @brief 3x4 row-major matrix (gp_Trsf::SetValues order) applied on top of the shape location, empty or undefined for identity
+    NumberArray transform;
+};
+
+static bool readTransform(const NumberArray& values, gp_Trsf& trsf)
+{
+    if (!values.isArray()) {
+        return false;
+    }
+    std::vector<double> m = vecFromJSArray<double>(values);
+    if (m.size() != 12) {
+        return false;
+    }
+    trsf.SetValues(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11]);
+    return true;
+}
+
+/// @brief Builds an XCAF document from a node table. Every distinct TShape becomes one part label and each
+/// node an assembly component, so instancing, names and colors survive the STEP/IGES writers.
+static Handle(TDocStd_Document) buildExportDocument(const std::vector<ExportNode>& nodes)
+{
+    Handle(TDocStd_Document) document = new TDocStd_Document("bincaf");
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+    Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+
+    TDF_Label assembly = shapeTool->NewShape();
+    TDataStd_Name::Set(assembly, "Assembly");
+
+    XCAFDoc_DataMapOfShapeLabel parts;
+    for (const auto& node : nodes) {
+        if (node.shape.IsNull()) {
+            continue;
+        }
+
+        Quantity_Color color;
+        bool hasColor = !node.color.empty() && Quantity_Color::ColorFromHex(node.color.c_str(), color);
+        TopoDS_Shape part = node.shape.Located(TopLoc_Location());
+        TDF_Label partLabel;
+        if (!parts.Find(part, partLabel)) {
+            partLabel = shapeTool->AddShape(part, false);
+            TDataStd_Name::Set(partLabel, TCollection_ExtendedString(node.name.c_str(), true));
+            if (hasColor) {
+                colorTool->SetColor(partLabel, color, XCAFDoc_ColorGen);
+            }
+            parts.Bind(part, partLabel);
+        }
+
+        gp_Trsf trsf;
+        TopLoc_Location location = node.shape.Location();
+        if (readTransform(node.transform, trsf)) {
+            location = TopLoc_Location(trsf) * location;
+        }
+        TDF_Label component = shapeTool->AddComponent(assembly, partLabel, location);
+        TDataStd_Name::Set(component, TCollection_ExtendedString(node.name.c_str(), true));
+
+        Quantity_Color partColor;
+        if (hasColor && (!colorTool->GetColor(partLabel, XCAFDoc_ColorGen, partColor) || partColor != color)) {
+            colorTool->SetColor(component, color, XCAFDoc_ColorGen);
+        }
+    }
+    shapeTool->UpdateAssemblies();
+
+    return document;
 }
 
+/// @brief Writes binary glTF (GLB) from a node table. Each distinct TShape and orientation is meshed once inside a
+/// ScopedTriangulation and written from the FaceMesher buffers, shared by every node instancing it; with
+/// quantization positions are stored as normalized uint16 and normals as normalized int8 (KHR_mesh_quantization),
+/// dequantized by the node matrix.
+class GlbWriter {
+private:
+    struct PartMesh {
+        int position;
+        int normal;
+        int index;
+        gp_Trsf dequantize;
+    };
+
+    double lineDeflection;
+    bool quantize;
+    std::vector<uint8_t> bin;
+    std::vector<std::string> bufferViews, accessors, meshes, materials, nodes;
+    /// @brief keyed by IsEqual, a reversed instance has the opposite winding
+    std::unordered_map<TopoDS_Shape, int> partIndices;
+    std::vector<std::optional<PartMesh>> parts;
+    std::map<std::pair<int, std::string>, int> meshIndices;
+    std::map<std::string, int> materialIndices;
+
+    static std::string number(double value, bool isFloat = false)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), isFloat ? "%.9g" : "%.17g", value);
+        return buffer;
+    }
+
+    static std::string quote(const std::string& value)
+    {
+        std::string result = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                result += buffer;
+            } else {
+                result += c;
+            }
+        }
+        return result + "\"";
+    }
+
+    static std::string join(const std::vector<std::string>& items)
+    {
+        std::string result = "[";
+        for (size_t i = 0; i < items.size(); i++) {
+            result += (i > 0 ? "," : "") + items[i];
+        }
+        return result + "]";
+    }
+
+    static std::string matrix(const gp_Trsf& trsf)
+    {
+        std::string result = "[";
+        for (int col = 1; col <= 4; col++) {
+            for (int row = 1; row <= 4; row++) {
+                double value = row == 4 ? (col == 4 ? 1.0 : 0.0) : trsf.Value(row, col);
+                result += (col + row > 2 ? "," : "") + number(value);
+            }
+        }
+        return result + "]";
+    }
+
+    int addBufferView(const void* data, size_t size, int byteStride, int target)
+    {
+        while (bin.size() % 4 != 0) {
+            bin.push_back(0);
+        }
+        size_t offset = bin.size();
+        bin.insert(bin.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+
+        std::string view = "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset)
+            + ",\"byteLength\":" + std::to_string(size) + ",\"target\":" + std::to_string(target);
+        if (byteStride > 0) {
+            view += ",\"byteStride\":" + std::to_string(byteStride);
+        }
+        bufferViews.push_back(view + "}");
+        return bufferViews.size() - 1;
+    }
+
+    int addAccessor(int bufferView, int componentType, size_t count, const std::string& type, bool normalized,
+        const std::string& bounds = "")
+    {
+        std::string accessor = "{\"bufferView\":" + std::to_string(bufferView)
+            + ",\"componentType\":" + std::to_string(componentType) + ",\"count\":" + std::to_string(count)
+            + ",\"type\":\"" + type + "\"";
+        if (normalized) {
+            accessor += ",\"normalized\":true";
+        }
+        accessors.push_back(accessor + bounds + "}");
+        return accessors.size() - 1;
+    }
+
+    PartMesh writeQuantizedVertices(const FaceMesher& mesher, const Bnd_Box& box)
+    {
+        double xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        double scale = std::max({ xMax - xMin, yMax - yMin, zMax - zMin });
+        if (scale < Precision::Confusion()) {
+            scale = 1.0;
+        }
+
+        size_t vertexCount = mesher.position.size() / 3;
+        std::vector<uint16_t> position(vertexCount * 4, 0);
+        std::vector<int8_t> normal(vertexCount * 4, 0);
+        const double origin[3] = { xMin, yMin, zMin };
+        uint16_t qMin[3] = { 65535, 65535, 65535 }, qMax[3] = { 0, 0, 0 };
+        for (size_t i = 0; i < vertexCount; i++) {
+            for (int c = 0; c < 3; c++) {
+                double t = (mesher.position[i * 3 + c] - origin[c]) / scale;
+                auto q = static_cast<uint16_t>(std::lround(std::clamp(t, 0.0, 1.0) * 65535.0));
+                position[i * 4 + c] = q;
+                qMin[c] = std::min(qMin[c], q);
+                qMax[c] = std::max(qMax[c], q);
+                normal[i * 4 + c] = static_cast<int8_t>(std::lround(std::clamp(mesher.normal[i * 3 + c], -1.0f, 1.0f) * 127.0f));
+            }
+        }
+
+        std::string bounds = ",\"min\":[" + std::to_string(qMin[0]) + "," + std::to_string(qMin[1]) + ","
+            + std::to_string(qMin[2]) + "],\"max\":[" + std::to_string(qMax[0]) + "," + std::to_string(qMax[1]) + ","
+            + std::to_string(qMax[2]) + "]";
+        int positionView = addBufferView(position.data(), position.size() * sizeof(uint16_t), 8, 34962);
+        int normalView = addBufferView(normal.data(), normal.size() * sizeof(int8_t), 4, 34962);
+
+        PartMesh part;
+        part.position = addAccessor(positionView, 5123, vertexCount, "VEC3", true, bounds);
+        part.normal = addAccessor(normalView, 5120, vertexCount, "VEC3", true);
+        gp_Trsf scaling;
+        scaling.SetScale(gp_Pnt(0, 0, 0), scale);
+        part.dequantize.SetTranslation(gp_Vec(xMin, yMin, zMin));
+        part.dequantize.Multiply(scaling);
+        return part;
+    }
+
+    PartMesh writeFloatVertices(const FaceMesher& mesher, const Bnd_Box& box)
+    {
+        double xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        std::string bounds = ",\"min\":[" + number(float(xMin), true) + "," + number(float(yMin), true) + ","
+            + number(float(zMin), true) + "],\"max\":[" + number(float(xMax), true) + "," + number(float(yMax), true)
+            + "," + number(float(zMax), true) + "]";
+
+        size_t vertexCount = mesher.position.size() / 3;
+        int positionView = addBufferView(mesher.position.data(), mesher.position.size() * sizeof(float), 0, 34962);
+        int normalView = addBufferView(mesher.normal.data(), mesher.normal.size() * sizeof(float), 0, 34962);
+
+        PartMesh part;
+        part.position = addAccessor(positionView, 5126, vertexCount, "VEC3", false, bounds);
+        part.normal = addAccessor(normalView, 5126, vertexCount, "VEC3", false);
+        return part;
+    }
+
+    template <typename T> int writeIndices(const std::vector<size_t>& index, int componentType)
+    {
+        std::vector<T> values(index.begin(), index.end());
+        int view = addBufferView(values.data(), values.size() * sizeof(T), 0, 34963);
+        return addAccessor(view, componentType, values.size(), "SCALAR", false);
+    }
+
+    std::optional<PartMesh> writePart(const TopoDS_Shape& part)
+    {
+        FaceMesher mesher;
+        {
+            ScopedTriangulation triangulation(part, lineDeflection);
+            std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)> facePolyMap;
+            mesher.generateShapeMesh(part, facePolyMap);
+        }
+        if (mesher.index.empty()) {
+            return std::nullopt;
+        }
+
+        Bnd_Box box;
+        for (size_t i = 0; i + 2 < mesher.position.size(); i += 3) {
+            box.Add(gp_Pnt(mesher.position[i], mesher.position[i + 1], mesher.position[i + 2]));
+        }
+
+        auto result = quantize ? writeQuantizedVertices(mesher, box) : writeFloatVertices(mesher, box);
+        result.index = mesher.position.size() / 3 <= 65535 ? writeIndices<uint16_t>(mesher.index, 5123)
+                                                          : writeIndices<uint32_t>(mesher.index, 5125);
+        return result;
+    }
+
+    int material(const std::string& hex)
+    {
+        auto it = materialIndices.find(hex);
+        if (it != materialIndices.end()) {
+            return it->second;
+        }
+
+        Quantity_Color color;
+        if (!Quantity_Color::ColorFromHex(hex.c_str(), color)) {
+            return -1;
+        }
+        materials.push_back("{\"pbrMetallicRoughness\":{\"baseColorFactor\":[" + number(color.Red(), true) + ","
+            + number(color.Green(), true) + "," + number(color.Blue(), true)
+            + ",1],\"metallicFactor\":0,\"roughnessFactor\":0.8},\"doubleSided\":true}");
+        materialIndices[hex] = materials.size() - 1;
+        return materials.size() - 1;
+    }
+
+    int meshOf(const TopoDS_Shape& shape, const std::string& color, gp_Trsf& dequantize)
+    {
+        TopoDS_Shape part = shape.Located(TopLoc_Location());
+        auto found = partIndices.find(part);
+        int partIndex;
+        if (found != partIndices.end()) {
+            partIndex = found->second;
+        } else {
+            partIndex = parts.size();
+            parts.push_back(writePart(part));
+            partIndices.emplace(part, partIndex);
+        }
+        if (!parts[partIndex].has_value()) {
+            return -1;
+        }
+
+        const auto& partMesh = parts[partIndex].value();
+        dequantize = partMesh.dequantize;
+        auto key = std::make_pair(partIndex, color);
+        auto it = meshIndices.find(key);
+        if (it != meshIndices.end()) {
+            return it->second;
+        }
+
+        std::string primitive = "{\"attributes\":{\"POSITION\":" + std::to_string(partMesh.position)
+            + ",\"NORMAL\":" + std::to_string(partMesh.normal) + "},\"indices\":" + std::to_string(partMesh.index)
+            + ",\"mode\":4";
+        int materialIndex = color.empty() ? -1 : material(color);
+        if (materialIndex >= 0) {
+            primitive += ",\"material\":" + std::to_string(materialIndex);
+        }
+        meshes.push_back("{\"primitives\":[" + primitive + "}]}");
+        meshIndices[key] = meshes.size() - 1;
+        return meshes.size() - 1;
+    }
+
+public:
+    GlbWriter(double lineDeflection, bool quantize)
+        : lineDeflection(lineDeflection)
+        , quantize(quantize)
+    {
+    }
+
+    void addNode(const ExportNode& node)
+    {
+        if (node.shape.IsNull()) {
+            return;
+        }
+
+        gp_Trsf transform, dequantize;
+        if (!readTransform(node.transform, transform)) {
+            transform = gp_Trsf();
+        }
+        transform.Multiply(node.shape.Location().Transformation());
+        int mesh = meshOf(node.shape, node.color, dequantize);
+        transform.Multiply(dequantize);
+
+        std::string json = "{\"name\":" + quote(node.name) + ",\"matrix\":" + matrix(transform);
+        if (mesh >= 0) {
+            json += ",\"mesh\":" + std::to_string(mesh);
+        }
+        nodes.push_back(json + "}");
+    }
+
+    void write(std::ostream& os)
+    {
+        // the root node turns the Z-up model into glTF's Y-up frame
+        std::vector<std::string> children;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            children.push_back(std::to_string(i + 1));
+        }
+        std::vector<std::string> allNodes = { "{\"name\":\"root\",\"rotation\":[-0.70710678118654757,0,0,"
+                                              "0.70710678118654757],\"children\":"
+            + join(children) + "}" };
+        allNodes.insert(allNodes.end(), nodes.begin(), nodes.end());
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"chili3d\"},\"scene\":0,\"scenes\":[{"
+                           "\"nodes\":[0]}],\"nodes\":"
+            + join(allNodes) + ",\"meshes\":" + join(meshes) + ",\"accessors\":" + join(accessors)
+            + ",\"bufferViews\":" + join(bufferViews) + ",\"buffers\":[{\"byteLength\":" + std::to_string(bin.size())
+            + "}]";
+        if (!materials.empty()) {
+            json += ",\"materials\":" + join(materials);
+        }
+        if (quantize) {
+            json += ",\"extensionsUsed\":[\"KHR_mesh_quantization\"],\"extensionsRequired\":[\"KHR_mesh_quantization\"]";
+        }
+        json += "}";
+
+        while (json.size() % 4 != 0) {
+            json += ' ';
+        }
+        while (bin.size() % 4 != 0) {
+            bin.push_back(0);
+        }
+
+        auto writeUint32 = [&os](uint32_t value) { os.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        writeUint32(0x46546C67); // "glTF"
+        writeUint32(2);
+        writeUint32(12 + 8 + json.size() + (bin.empty() ? 0 : 8 + bin.size()));
+        writeUint32(json.size());
+        writeUint32(0x4E4F534A); // "JSON"
+        os.write(json.data(), json.size());
+        if (!bin.empty()) {
+            writeUint32(bin.size());
+            writeUint32(0x004E4942); // "BIN"
+            os.write(reinterpret_cast<const char*>(bin.data()), bin.size());
+        }
+    }
+};
+
+/// @brief Writes binary STL from the triangulations attached to the faces (see ScopedTriangulation for how the
+/// callers provide them); the output size is known up front, so triangles are written straight into one exactly
+/// sized buffer.
+class StlWriter {
+private:
+    static constexpr size_t HEADER_SIZE = 84;
+    static constexpr size_t TRIANGLE_SIZE = 50;
+
+    static size_t countTriangles(const TopoDS_Shape& shape)
+    {
+        size_t count = 0;
+        TopLoc_Location location;
+        for (TopExp_Explorer explorer(shape, TopAbs_FACE); explorer.More(); explorer.Next()) {
+            auto triangulation = BRep_Tool::Triangulation(TopoDS::Face(explorer.Current()), location);
+            if (!triangulation.IsNull()) {
+                count += triangulation->NbTriangles();
+            }
+        }
+        return count;
+    }
+
+    static void putVector(uint8_t*& out, double x, double y, double z)
+    {
+        float values[3] = { float(x), float(y), float(z) };
+        std::memcpy(out, values, sizeof(values));
+        out += sizeof(values);
+    }
+
+    static void writeTriangles(const TopoDS_Shape& shape, uint8_t*& out)
+    {
+        for (TopExp_Explorer explorer(shape, TopAbs_FACE); explorer.More(); explorer.Next()) {
+            const TopoDS_Face& face = TopoDS::Face(explorer.Current());
+            TopLoc_Location location;
+            auto triangulation = BRep_Tool::Triangulation(face, location);
+            if (triangulation.IsNull()) {
+                continue;
+            }
+
+            const gp_Trsf& trsf = location.Transformation();
+            bool flip = (face.Orientation() == TopAbs_REVERSED) ^ (trsf.VectorialPart().Determinant() < 0);
+            for (int i = 1; i <= triangulation->NbTriangles(); i++) {
+                int n1, n2, n3;
+                triangulation->Triangle(i).Get(n1, n2, n3);
+                if (flip) {
+                    std::swap(n2, n3);
+                }
+                gp_Pnt p1 = triangulation->Node(n1).Transformed(trsf);
+                gp_Pnt p2 = triangulation->Node(n2).Transformed(trsf);
+                gp_Pnt p3 = triangulation->Node(n3).Transformed(trsf);
+
+                gp_XYZ normal = (p2.XYZ() - p1.XYZ()).Crossed(p3.XYZ() - p1.XYZ());
+                double modulus = normal.Modulus();
+                if (modulus > gp::Resolution()) {
+                    normal /= modulus;
+                }
+                putVector(out, normal.X(), normal.Y(), normal.Z());
+                putVector(out, p1.X(), p1.Y(), p1.Z());
+                putVector(out, p2.X(), p2.Y(), p2.Z());
+                putVector(out, p3.X(), p3.Y(), p3.Z());
+                out[0] = out[1] = 0;
+                out += 2;
+            }
+        }
+    }
+
+public:
+    static Uint8Array write(const std::vector<TopoDS_Shape>& shapes)
+    {
+        size_t triangleCount = 0;
+        for (const auto& shape : shapes) {
+            triangleCount += countTriangles(shape);
+        }
+
+        std::vector<uint8_t> bytes(HEADER_SIZE + triangleCount * TRIANGLE_SIZE, 0);
+        const char header[] = "binary STL exported by chili3d";
+        std::memcpy(bytes.data(), header, sizeof(header) - 1);
+        uint32_t count = triangleCount;
+        std::memcpy(bytes.data() + 80, &count, sizeof(count));
+
+        uint8_t* out = bytes.data() + HEADER_SIZE;
+        for (const auto& shape : shapes) {
+            writeTriangles(shape, out);
+        }
+        return Uint8Array(val(typed_memory_view(bytes.size(), bytes.data())).call<val>("slice"));
+    }
+};
+
+/// @brief Binary layout of an import cache blob:
+/// magic, version, flags, content hash, node tree (name, color, shape index, child count; depth first),
+/// followed by every node shape in one compound written with BinTools so instanced TShapes are stored once.
+class ImportCache {
+private:
+    static constexpr char MAGIC[8] = { 'C', 'H', 'I', 'L', 'I', 'C', 'A', 'C' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t FLAG_TRIANGLES = 1;
+    /// @brief smallest encoded node: name size, color flag, shape index and child count
+    static constexpr std::streamsize MIN_NODE_SIZE = 13;
+    static constexpr int MAX_DEPTH = 512;
+
+    template <typename T> static void write(std::ostream& os, T value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void writeString(std::ostream& os, const std::string& value)
+    {
+        write<uint32_t>(os, value.size());
+        os.write(value.data(), value.size());
+    }
+
+    template <typename T> static bool read(std::istream& is, T& value)
+    {
+        return bool(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    /// @brief bytes left in the stream; the blob is fully buffered in memory (VectorBuffer), so the get area
+    /// holds the whole remainder
+    static std::streamsize remaining(std::istream& is)
+    {
+        std::streamsize available = is.rdbuf()->in_avail();
+        return available > 0 ? available : 0;
+    }
+
+    static bool readString(std::istream& is, std::string& value)
+    {
+        uint32_t size;
+        if (!read(is, size) || size > remaining(is)) {
+            return false;
+        }
+        value.resize(size);
+        return size == 0 || bool(is.read(value.data(), size));
+    }
+
+    static void writeNode(std::ostream& os, const ShapeNode& node, BRep_Builder& builder, TopoDS_Compound& shapes,
+        int32_t& shapeCount)
+    {
+        writeString(os, node.name);
+        write<uint8_t>(os, node.color.has_value());
+        if (node.color.has_value()) {
+            writeString(os, node.color.value());
+        }
+
+        if (node.shape.has_value() && !node.shape->IsNull()) {
+            builder.Add(shapes, node.shape.value());
+            write<int32_t>(os, shapeCount++);
+        } else {
+            write<int32_t>(os, -1);
+        }
+
+        write<uint32_t>(os, node.children.size());
+        for (const auto& child : node.children) {
+            writeNode(os, child, builder, shapes, shapeCount);
+        }
+    }
+
+    static bool readNode(std::istream& is, ShapeNode& node, std::vector<int32_t>& shapeIndices,
+        std::vector<ShapeNode*>& shapeNodes, int depth = 0)
+    {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+        uint8_t hasColor;
+        if (!readString(is, node.name) || !read(is, hasColor)) {
+            return false;
+        }
+        if (hasColor) {
+            std::string color;
+            if (!readString(is, color)) {
+                return false;
+            }
+            node.color = color;
+        }
+
+        int32_t shapeIndex;
+        uint32_t childCount;
+        // a corrupt count must not allocate more nodes than the rest of the tree could encode
+        if (!read(is, shapeIndex) || !read(is, childCount) || childCount > remaining(is) / MIN_NODE_SIZE) {
+            return false;
+        }
+
+        node.children.resize(childCount);
+        for (auto& child : node.children) {
+            if (!readNode(is, child, shapeIndices, shapeNodes, depth + 1)) {
+                return false;
+            }
+        }
+
+        // children are complete, so their addresses are stable from here on
+        if (shapeIndex >= 0) {
+            shapeIndices.push_back(shapeIndex);
+            shapeNodes.push_back(&node);
+        }
+        return true;
+    }
+
+public:
+    static void save(std::ostream& os, const ShapeNode& root, const std::string& hash, double lineDeflection)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound shapes;
+        builder.MakeCompound(shapes);
+
+        std::ostringstream tree;
+        int32_t shapeCount = 0;
+        writeNode(tree, root, builder, shapes, shapeCount);
+
+        // the triangles are only borrowed for BinTools::Write, the caller's faces keep their own
+        bool withTriangles = lineDeflection > 0;
+        std::unique_ptr<ScopedTriangulation> triangulation;
+        if (withTriangles) {
+            triangulation = std::make_unique<ScopedTriangulation>(shapes, lineDeflection);
+        }
+
+        os.write(MAGIC, sizeof(MAGIC));
+        write<uint32_t>(os, VERSION);
+        write<uint32_t>(os, withTriangles ? FLAG_TRIANGLES : 0);
+        writeString(os, hash);
+        writeString(os, tree.str());
+        BinTools::Write(shapes, os, withTriangles, false, BinTools_FormatVersion_CURRENT);
+    }
+
+    static std::optional<ShapeNode> load(std::istream& is, const std::string& expectedHash)
+    {
+        char magic[sizeof(MAGIC)];
+        uint32_t version, flags;
+        std::string hash, tree;
+        if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !read(is, version)
+            || version != VERSION || !read(is, flags) || !readString(is, hash) || !readString(is, tree)) {
+            return std::nullopt;
+        }
+        if (!expectedHash.empty() && hash != expectedHash) {
+            return std::nullopt;
+        }
+
+        ShapeNode root;
+        std::vector<int32_t> shapeIndices;
+        std::vector<ShapeNode*> shapeNodes;
+        std::istringstream treeStream(tree);
+        if (!readNode(treeStream, root, shapeIndices, shapeNodes)) {
+            return std::nullopt;
+        }
+
+        // BinTools throws on malformed input, which aborts a build without exception catching
+        if (!is.good() || remaining(is) == 0) {
+            return std::nullopt;
+        }
+        TopoDS_Shape compound;
+        BinTools::Read(compound, is);
+        if (is.fail() || compound.IsNull()) {
+            return std::nullopt;
+        }
+        std::vector<TopoDS_Shape> shapes;
+        for (TopoDS_Iterator it(compound); it.More(); it.Next()) {
+            shapes.push_back(it.Value());
+        }
+
+        for (size_t i = 0; i < shapeNodes.size(); i++) {
+            if (shapeIndices[i] >= static_cast<int32_t>(shapes.size())) {
+                return std::nullopt;
+            }
+            shapeNodes[i]->shape = shapes[shapeIndices[i]];
+        }
+        return root;
+    }
+};
+
 class Converter {
 private:
+    inline static ImportStatistics lastStatistics {};
+
     static TopoDS_Shape sewShapes(const std::vector<TopoDS_Shape>& shapes)
     {
         BRepBuilderAPI_Sewing sewing;
@@ -287,6 +1205,34 @@ private:
     }
 
 public:
+    static ImportStatistics lastImportStatistics()
+    {
+        return lastStatistics;
+    }
+
+    static std::string contentHash(const Uint8Array& buffer)
+    {
+        std::vector<uint8_t> input = convertJSArrayToNumberVector<uint8_t>(buffer);
+        return toHex(contentHash64(input.data(), input.size()));
+    }
+
+    static Uint8Array convertToCache(const ShapeNode& node, const std::string& hash, double lineDeflection)
+    {
+        ByteBuffer buffer;
+        std::ostream os(&buffer);
+        ImportCache::save(os, node, hash, lineDeflection);
+        return buffer.toUint8Array();
+    }
+
+    static std::optional<ShapeNode> convertFromCache(const Uint8Array& buffer, const std::string& hash)
+    {
+        lastStatistics = ImportStatistics();
+        std::vector<uint8_t> input = convertJSArrayToNumberVector<uint8_t>(buffer);
+        VectorBuffer vectorBuffer(input);
+        std::istream iss(&vectorBuffer);
+        return ImportCache::load(iss, hash);
+    }
+
     static std::string convertToBrep(const TopoDS_Shape& input)
     {
         std::ostringstream oss;
@@ -305,6 +1251,7 @@ public:
 
     static std::optional<ShapeNode> convertFromStep(const Uint8Array& buffer)
     {
+        lastStatistics = ImportStatistics();
         std::vector<uint8_t> input = convertJSArrayToNumberVector<uint8_t>(buffer);
         VectorBuffer vectorBuffer(input);
         std::istream iss(&vectorBuffer);
@@ -323,11 +1270,12 @@ public:
             return std::nullopt;
         }
 
-        return parseNodeFromDocument(document);
+        return parseNodeFromDocument(document, lastStatistics);
     }
 
     static std::optional<ShapeNode> convertFromIges(const Uint8Array& buffer)
     {
+        lastStatistics = ImportStatistics();
         std::string dummyFileName = "temp.igs";
         writeBufferToFile(dummyFileName, buffer);
 
@@ -345,7 +1293,7 @@ public:
             return std::nullopt;
         }
         std::remove(dummyFileName.c_str());
-        return parseNodeFromDocument(document);
+        return parseNodeFromDocument(document, lastStatistics);
     }
 
     static std::string convertToStep(const ShapeArray& input)
@@ -373,8 +1321,93 @@ public:
         return oss.str();
     }
 
+    static std::optional<Uint8Array> convertNodesToStep(const ExportNodeArray& input)
+    {
+        auto document = buildExportDocument(vecFromJSArray<ExportNode>(input));
+
+        STEPCAFControl_Writer stepWriter;
+        stepWriter.SetColorMode(true);
+        stepWriter.SetNameMode(true);
+        if (!stepWriter.Transfer(document, STEPControl_AsIs)) {
+            return std::nullopt;
+        }
+
+        ByteBuffer buffer;
+        std::ostream os(&buffer);
+        if (stepWriter.ChangeWriter().WriteStream(os) != IFSelect_RetDone) {
+            return std::nullopt;
+        }
+        return buffer.toUint8Array();
+    }
+
+    static std::optional<Uint8Array> convertNodesToIges(const ExportNodeArray& input)
+    {
+        auto document = buildExportDocument(vecFromJSArray<ExportNode>(input));
+
+        IGESCAFControl_Writer igesWriter;
+        igesWriter.SetColorMode(true);
+        igesWriter.SetNameMode(true);
+        if (!igesWriter.Transfer(document)) {
+            return std::nullopt;
+        }
+
+        ByteBuffer buffer;
+        std::ostream os(&buffer);
+        if (!igesWriter.Write(os)) {
+            return std::nullopt;
+        }
+        return buffer.toUint8Array();
+    }
+
+    static Uint8Array convertNodesToGlb(const ExportNodeArray& input, double lineDeflection, bool quantize)
+    {
+        GlbWriter writer(lineDeflection, quantize);
+        for (const auto& node : vecFromJSArray<ExportNode>(input)) {
+            writer.addNode(node);
+        }
+
+        ByteBuffer buffer;
+        std::ostream os(&buffer);
+        writer.write(os);
+        return buffer.toUint8Array();
+    }
+
+    static Uint8Array convertToStl(const ShapeArray& input, double lineDeflection)
+    {
+        auto shapes = vecFromJSArray<TopoDS_Shape>(input);
+        std::vector<std::unique_ptr<ScopedTriangulation>> triangulations;
+        for (const auto& shape : shapes) {
+            triangulations.push_back(std::make_unique<ScopedTriangulation>(shape, lineDeflection));
+        }
+        auto stl = StlWriter::write(shapes);
+
+        // restore in reverse, so a face shared by several shapes ends up with its original triangulation
+        while (!triangulations.empty()) {
+            triangulations.pop_back();
+        }
+        return stl;
+    }
+
+    static Uint8ArrayArray convertToStlPerSolid(const ShapeArray& input, double lineDeflection)
+    {
+        val files = val::array();
+        for (const auto& shape : vecFromJSArray<TopoDS_Shape>(input)) {
+            ScopedTriangulation triangulation(shape, lineDeflection);
+            bool hasSolid = false;
+            for (TopExp_Explorer explorer(shape, TopAbs_SOLID); explorer.More(); explorer.Next()) {
+                files.call<void>("push", StlWriter::write({ explorer.Current() }));
+                hasSolid = true;
+            }
+            if (!hasSolid) {
+                files.call<void>("push", StlWriter::write({ shape }));
+            }
+        }
+        return Uint8ArrayArray(files);
+    }
+
     static std::optional<ShapeNode> convertFromStl(const Uint8Array& buffer)
     {
+        lastStatistics = ImportStatistics();
         std::string dummyFileName = "temp.stl";
         writeBufferToFile(dummyFileName, buffer);
 
@@ -395,6 +1428,26 @@ EMSCRIPTEN_BINDINGS(Converter)
     register_optional<ShapeNode>();
 
     register_type<ShapeNodeArray>("Array<ShapeNode>");
+    register_type<ExportNodeArray>("Array<ExportNode>");
+    register_optional<Uint8Array>();
+    register_type<Uint8ArrayArray>("Array<Uint8Array>");
+
+    // ExportNode：导出节点表的一行（形状、名称、颜色 hex、可选 3x4 变换矩阵）
+    value_object<ExportNode>("ExportNode")
+        .field("shape", &ExportNode::shape)
+        .field("name", &ExportNode::name)
+        .field("color", &ExportNode::color)
+        .field("transform", &ExportNode::transform);
+
+    // ImportStatistics：最近一次导入时 XCAF 属性查找的统计（标签数、形状/名称/颜色查找次数及实际转换次数）
+    value_object<ImportStatistics>("ImportStatistics")
+        .field("labelCount", &ImportStatistics::labelCount)
+        .field("shapeLookups", &ImportStatistics::shapeLookups)
+        .field("shapeMisses", &ImportStatistics::shapeMisses)
+        .field("nameLookups", &ImportStatistics::nameLookups)
+        .field("nameConversions", &ImportStatistics::nameConversions)
+        .field("colorLookups", &ImportStatistics::colorLookups)
+        .field("colorQueries", &ImportStatistics::colorQueries);
 
     // ShapeNode 暴露：表示解析后层次结构节点（可能包含 TopoDS_Shape、颜色、名称与子节点）
     class_<ShapeNode>("ShapeNode")
@@ -405,9 +1458,23 @@ EMSCRIPTEN_BINDINGS(Converter)
         // name 属性：节点/形状的名称（从 XCAF 文档读取）
         .property("name", &ShapeNode::name)
         // getChildren()：返回子节点数组（用于在 JS 端遍历层次结构）
-        .function("getChildren", &ShapeNode::getChildren);
+        .function("getChildren", &ShapeNode::getChildren)
+        // getBounds(oriented) -> BoundsHierarchy：按节点树打包各节点、实体和面的包围盒，用于视锥剔除和 LOD
+        .function("getBounds", &ShapeNode::getBounds);
 
     class_<Converter>("Converter")
+        // 返回最近一次 convertFromStep / convertFromIges / convertFromStl 的属性查找统计
+        .class_function("lastImportStatistics", &Converter::lastImportStatistics)
+
+        // 计算输入字节流的 64 位内容哈希（十六进制字符串），用作导入缓存的键
+        .class_function("contentHash", &Converter::contentHash)
+
+        // 将导入得到的 ShapeNode 层次结构序列化为缓存块（二进制 BRep + 节点树），lineDeflection > 0 时同时保存三角化
+        .class_function("convertToCache", &Converter::convertToCache)
+
+        // 从缓存块恢复 ShapeNode，hash 非空时需与缓存中的内容哈希一致，否则返回 nullopt
+        .class_function("convertFromCache", &Converter::convertFromCache)
+
         // 将 TopoDS_Shape 序列化为 BREP 格式的字符串（使用 BRepTools::Write）
         // JS 侧可直接得到 BREP 文本以便保存或传输
         .class_function("convertToBrep", &Converter::convertToBrep)
@@ -433,6 +1500,23 @@ EMSCRIPTEN_BINDINGS(Converter)
         // 实现：遍历输入 shapes -> AddShape / ComputeModel -> 写入字符串流并返回
         .class_function("convertToIges", &Converter::convertToIges)
 
+        // 将节点表（形状/名称/颜色/变换）构建为 XCAF 装配文档并用 STEPCAFControl_Writer 直接写入字节缓冲区
+        // 相同 TShape 只作为一个零件导出，名称与颜色得以保留；失败返回 nullopt
+        .class_function("convertNodesToStep", &Converter::convertNodesToStep)
+
+        // 同 convertNodesToStep，使用 IGESCAFControl_Writer 导出 IGES 字节
+        .class_function("convertNodesToIges", &Converter::convertNodesToIges)
+
+        // 将节点表导出为二进制 glTF（GLB）：相同 TShape 只网格化一次并在多个节点间共享网格，
+        // quantize 为 true 时使用 KHR_mesh_quantization（uint16 位置 / int8 法线）
+        .class_function("convertNodesToGlb", &Converter::convertNodesToGlb)
+
+        // 将一组 shape 导出为二进制 STL：在临时三角化范围内（ScopedTriangulation）网格化后写入 Uint8Array，结束后恢复面上原有的三角化
+        .class_function("convertToStl", &Converter::convertToStl)
+
+        // 同 convertToStl，但每个实体（无实体的 shape 则整体）输出为一个独立的 STL 文件
+        .class_function("convertToStlPerSolid", &Converter::convertToStlPerSolid)
+
         // 从 STL 字节流解析为 TopoDS_Shape 并封装为 ShapeNode（使用 StlAPI_Reader）
         // 实现：将字节写入临时 .stl 文件 -> 使用 StlAPI_Reader 读取为 TopoDS_Shape -> 返回包含该 shape 的 ShapeNode
         .class_function("convertFromStl", &Converter::convertFromStl);
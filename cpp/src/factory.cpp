@@ -4,12 +4,16 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 
+#include "memory.hpp"
 #include "shared.hpp"
+#include "topology.hpp"
 #include "utils.hpp"
+#include <BOPAlgo_CellsBuilder.hxx>
+#include <BOPAlgo_GlueEnum.hxx>
+#include <BOPAlgo_Operation.hxx>
+#include <BOPAlgo_PaveFiller.hxx>
 #include <BRepAlgoAPI_BooleanOperation.hxx>
-#include <BRepAlgoAPI_Common.hxx>
-#include <BRepAlgoAPI_Cut.hxx>
-#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepAdaptor_CompCurve.hxx>
 #include <BRepBuilderAPI_GTransform.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
@@ -30,14 +34,35 @@
 #include <BRepPrimAPI_MakeRevol.hxx>
 #include <BRepPrimAPI_MakeSphere.hxx>
 #include <BRepProj_Projection.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <GCPnts_UniformAbscissa.hxx>
 #include <Geom_BezierCurve.hxx>
+#include <OSD_Parallel.hxx>
 #include <ShapeAnalysis_Edge.hxx>
 #include <ShapeAnalysis_WireOrder.hxx>
 #include <ShapeUpgrade_UnifySameDomain.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Shape.hxx>
+#include <gp.hxx>
 #include <gp_Ax2.hxx>
 #include <gp_Circ.hxx>
+#include <gp_Quaternion.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
 
 using namespace emscripten;
 
@@ -47,6 +72,34 @@ struct ShapeResult {
     std::string error;
 };
 
+struct BooleanOptions {
+    /// @brief run the intersection stages with OSD_Parallel (real threads only in a CHILI_WASM_THREADS build)
+    bool parallel;
+    /// @brief pre-filter interfering sub-shapes with oriented bounding boxes
+    bool useOBB;
+    /// @brief additional tolerance for near-coincident geometry, 0 to disable
+    double fuzzyValue;
+    /// @brief gluing mode for arguments sharing coincident faces (no real face intersections)
+    BOPAlgo_GlueEnum glue;
+    /// @brief keep the input shapes untouched (required when the arguments are shared with the document)
+    bool nonDestructive;
+};
+
+enum class PrimitiveType {
+    /// @brief dimensions: x, y, z
+    Box,
+    /// @brief dimensions: radius, height
+    Cylinder,
+    /// @brief dimensions: radius
+    Sphere,
+    /// @brief dimensions: radius, radiusUp, height
+    Cone,
+};
+
+/// @brief One primitive per record: type, location xyz, direction xyz, xDirection xyz, 3 dimensions.
+/// Sphere ignores the directions, cylinder and cone ignore xDirection.
+constexpr size_t PRIMITIVE_RECORD_SIZE = 13;
+
 class ShapeFactory {
 public:
     static ShapeResult box(const Pln& ax3, double x, double y, double z)
@@ -79,6 +132,116 @@ public:
         return ShapeResult { sphere, true, "" };
     }
 
+    /// @brief why the record would make the OCCT constructors throw, empty when it is valid. A throw aborts the whole
+    /// batch in a build without exception catching, so the records are checked up front.
+    static std::string invalidPrimitive(const double* record)
+    {
+        for (size_t i = 0; i < PRIMITIVE_RECORD_SIZE; i++) {
+            if (!std::isfinite(record[i])) {
+                return "Record values must be finite";
+            }
+        }
+        double type = record[0];
+        if (type != std::floor(type) || type < 0 || type > static_cast<double>(PrimitiveType::Cone)) {
+            return "Unknown primitive type";
+        }
+
+        const double* dimensions = record + 10;
+        auto primitiveType = static_cast<PrimitiveType>(type);
+        if (primitiveType == PrimitiveType::Sphere) {
+            return dimensions[0] > Precision::Confusion() ? "" : "Invalid dimensions";
+        }
+
+        gp_Vec direction(record[4], record[5], record[6]);
+        if (direction.Magnitude() <= gp::Resolution()) {
+            return "Invalid direction";
+        }
+        if (primitiveType == PrimitiveType::Box) {
+            gp_Vec xDirection(record[7], record[8], record[9]);
+            if (xDirection.Magnitude() <= gp::Resolution() || direction.IsParallel(xDirection, Precision::Angular())) {
+                return "Invalid xDirection";
+            }
+            bool valid = std::all_of(dimensions, dimensions + 3, [](double d) { return d > Precision::Confusion(); });
+            return valid ? "" : "Invalid dimensions";
+        }
+        if (primitiveType == PrimitiveType::Cylinder) {
+            bool valid = dimensions[0] > Precision::Confusion() && dimensions[1] > Precision::Confusion();
+            return valid ? "" : "Invalid dimensions";
+        }
+
+        // a cone radius may be 0 for the apex, but not both and not equal
+        double radius = dimensions[0], radiusUp = dimensions[1], height = dimensions[2];
+        bool valid = radius >= 0 && radiusUp >= 0 && std::abs(radius - radiusUp) > Precision::Confusion()
+            && (radius == 0 || radius > Precision::Confusion()) && (radiusUp == 0 || radiusUp > Precision::Confusion())
+            && height > Precision::Confusion();
+        return valid ? "" : "Invalid dimensions";
+    }
+
+    static ShapeResult primitive(const double* record)
+    {
+        auto reason = invalidPrimitive(record);
+        if (!reason.empty()) {
+            return ShapeResult { TopoDS_Shape(), false, reason };
+        }
+
+        Vector3 location { record[1], record[2], record[3] };
+        Vector3 direction { record[4], record[5], record[6] };
+        Vector3 xDirection { record[7], record[8], record[9] };
+        const double* dimensions = record + 10;
+        switch (static_cast<PrimitiveType>(record[0])) {
+        case PrimitiveType::Box:
+            return box(Pln { location, direction, xDirection }, dimensions[0], dimensions[1], dimensions[2]);
+        case PrimitiveType::Cylinder:
+            return cylinder(direction, location, dimensions[0], dimensions[1]);
+        case PrimitiveType::Sphere:
+            return sphere(location, dimensions[0]);
+        case PrimitiveType::Cone:
+            return cone(direction, location, dimensions[0], dimensions[1], dimensions[2]);
+        }
+        return ShapeResult { TopoDS_Shape(), false, "Unknown primitive type" };
+    }
+
+    /// @brief builds every record of the batch, in parallel in a CHILI_WASM_THREADS build; a trailing partial
+    /// record is reported as a failed one
+    static std::vector<ShapeResult> buildPrimitives(const Float64Array& records)
+    {
+        std::vector<double> values = convertJSArrayToNumberVector<double>(records);
+        int count = values.size() / PRIMITIVE_RECORD_SIZE;
+        std::vector<ShapeResult> results(count);
+        OSD_Parallel::For(0, count, [&](int i) { results[i] = primitive(values.data() + i * PRIMITIVE_RECORD_SIZE); });
+        if (values.size() % PRIMITIVE_RECORD_SIZE != 0) {
+            results.push_back(ShapeResult { TopoDS_Shape(), false,
+                "Record length must be a multiple of " + std::to_string(PRIMITIVE_RECORD_SIZE) });
+        }
+        return results;
+    }
+
+    static ShapeResult primitivesCompound(const Float64Array& records)
+    {
+        auto results = buildPrimitives(records);
+        TopoDS_Compound compound;
+        BRep_Builder builder;
+        builder.MakeCompound(compound);
+        for (size_t i = 0; i < results.size(); i++) {
+            if (!results[i].isOk) {
+                return ShapeResult { TopoDS_Shape(), false,
+                    "Failed to create primitive " + std::to_string(i) + ": " + results[i].error };
+            }
+            builder.Add(compound, results[i].shape);
+        }
+        return ShapeResult { compound, true, "" };
+    }
+
+    /// @brief failed records yield a null shape at their position
+    static ShapeArray primitives(const Float64Array& records)
+    {
+        std::vector<TopoDS_Shape> shapes;
+        for (const auto& result : buildPrimitives(records)) {
+            shapes.push_back(result.shape);
+        }
+        return ShapeArray(val::array(shapes));
+    }
+
     static ShapeResult ellipse(const Vector3& normal, const Vector3& center, const Vector3& xvec, double majorRadius,
         double minorRadius)
     {
@@ -351,7 +514,11 @@ public:
 
     static ShapeResult wire(const EdgeArray& edges)
     {
-        std::vector<TopoDS_Edge> edgesVec = vecFromJSArray<TopoDS_Edge>(edges);
+        return wireFromEdges(vecFromJSArray<TopoDS_Edge>(edges));
+    }
+
+    static ShapeResult wireFromEdges(const std::vector<TopoDS_Edge>& edgesVec)
+    {
         if (edgesVec.size() == 0) {
             return ShapeResult { TopoDS_Shape(), false, "No edges provided" };
         }
@@ -370,7 +537,14 @@ public:
 
     static ShapeResult face(const WireArray& wires)
     {
-        std::vector<TopoDS_Wire> wiresVec = vecFromJSArray<TopoDS_Wire>(wires);
+        return faceFromWires(vecFromJSArray<TopoDS_Wire>(wires));
+    }
+
+    static ShapeResult faceFromWires(const std::vector<TopoDS_Wire>& wiresVec)
+    {
+        if (wiresVec.empty()) {
+            return ShapeResult { TopoDS_Shape(), false, "No wires provided" };
+        }
         BRepBuilderAPI_MakeFace makeFace(wiresVec[0]);
         for (int i = 1; i < wiresVec.size(); i++) {
             makeFace.Add(wiresVec[i]);
@@ -446,13 +620,55 @@ public:
         return ShapeResult { anUnifier.Shape(), true, "" };
     }
 
-    static ShapeResult booleanOperate(BRepAlgoAPI_BooleanOperation& boolOperater, const ShapeArray& args,
-        const ShapeArray& tools)
+    static ShapeResult booleanOperate(BOPAlgo_Operation operation, const ShapeArray& args, const ShapeArray& tools)
     {
-        TopTools_ListOfShape argsList = shapeArrayToListOfShape(args);
-        TopTools_ListOfShape toolsList = shapeArrayToListOfShape(tools);
+        // the arguments may share TShapes with other shapes (cloneShared, patterns), so never modify them
+        BooleanOptions options = { .parallel = false,
+            .useOBB = false,
+            .fuzzyValue = 0,
+            .glue = BOPAlgo_GlueOff,
+            .nonDestructive = true };
+        return booleanOperate(operation, args, tools, options);
+    }
 
+    static ShapeResult booleanOperate(BOPAlgo_Operation operation, const ShapeArray& args, const ShapeArray& tools,
+        const BooleanOptions& options)
+    {
+        return booleanOperate(operation, shapeArrayToListOfShape(args), shapeArrayToListOfShape(tools), options);
+    }
+
+    /// @brief The intersection stage runs in an explicit pave filler so that, in arena mode, its data structure
+    /// is allocated from the call's arena and released in one go when the call returns.
+    static ShapeResult booleanOperate(BOPAlgo_Operation operation, const TopTools_ListOfShape& argsList,
+        const TopTools_ListOfShape& toolsList, const BooleanOptions& options)
+    {
+        ArenaScope arena;
+        TopTools_ListOfShape shapes;
+        for (const auto& shape : argsList) {
+            shapes.Append(shape);
+        }
+        for (const auto& shape : toolsList) {
+            shapes.Append(shape);
+        }
+
+        BOPAlgo_PaveFiller filler(MemoryArena::allocator());
+        filler.SetArguments(shapes);
+        filler.SetRunParallel(options.parallel);
+        filler.SetUseOBB(options.useOBB);
+        if (options.fuzzyValue > 0) {
+            filler.SetFuzzyValue(options.fuzzyValue);
+        }
+        filler.SetGlue(options.glue);
+        filler.SetNonDestructive(options.nonDestructive);
+        filler.Perform();
+        if (filler.HasErrors()) {
+            return ShapeResult { TopoDS_Shape(), false, "Failed to intersect boolean arguments" };
+        }
+
+        BRepAlgoAPI_BooleanOperation boolOperater(filler);
+        boolOperater.SetOperation(operation);
         boolOperater.SetToFillHistory(false);
+        boolOperater.SetRunParallel(options.parallel);
         boolOperater.SetArguments(argsList);
         boolOperater.SetTools(toolsList);
         boolOperater.Build();
@@ -465,20 +681,35 @@ public:
 
     static ShapeResult booleanCommon(const ShapeArray& args, const ShapeArray& tools)
     {
-        BRepAlgoAPI_Common api;
-        return booleanOperate(api, args, tools);
+        return booleanOperate(BOPAlgo_COMMON, args, tools);
     }
 
     static ShapeResult booleanCut(const ShapeArray& args, const ShapeArray& tools)
     {
-        BRepAlgoAPI_Cut api;
-        return booleanOperate(api, args, tools);
+        return booleanOperate(BOPAlgo_CUT, args, tools);
     }
 
     static ShapeResult booleanFuse(const ShapeArray& args, const ShapeArray& tools)
     {
-        BRepAlgoAPI_Fuse api;
-        return booleanOperate(api, args, tools);
+        return booleanOperate(BOPAlgo_FUSE, args, tools);
+    }
+
+    static ShapeResult booleanCommonWithOptions(const ShapeArray& args, const ShapeArray& tools,
+        const BooleanOptions& options)
+    {
+        return booleanOperate(BOPAlgo_COMMON, args, tools, options);
+    }
+
+    static ShapeResult booleanCutWithOptions(const ShapeArray& args, const ShapeArray& tools,
+        const BooleanOptions& options)
+    {
+        return booleanOperate(BOPAlgo_CUT, args, tools, options);
+    }
+
+    static ShapeResult booleanFuseWithOptions(const ShapeArray& args, const ShapeArray& tools,
+        const BooleanOptions& options)
+    {
+        return booleanOperate(BOPAlgo_FUSE, args, tools, options);
     }
 
     static ShapeResult combine(const ShapeArray& shapes)
@@ -493,13 +724,126 @@ public:
         return ShapeResult { compound, true, "" };
     }
 
+    /// @brief Instances are the same TShape under different TopLoc_Location, so meshing and serialization
+    /// share one copy of the geometry. The first instance keeps the original placement.
+    static ShapeResult pattern(const TopoDS_Shape& shape, const std::vector<gp_Trsf>& transforms)
+    {
+        if (shape.IsNull() || transforms.empty()) {
+            return ShapeResult { TopoDS_Shape(), false, "Nothing to pattern" };
+        }
+
+        TopoDS_Compound compound;
+        BRep_Builder builder;
+        builder.MakeCompound(compound);
+        for (const auto& trsf : transforms) {
+            builder.Add(compound, shape.Moved(TopLoc_Location(trsf)));
+        }
+        return ShapeResult { compound, true, "" };
+    }
+
+    static ShapeResult linearPattern(const TopoDS_Shape& shape, const Vector3& step, int count)
+    {
+        std::vector<gp_Trsf> transforms;
+        for (int i = 0; i < count; i++) {
+            gp_Trsf trsf;
+            trsf.SetTranslation(Vector3::toVec(step) * i);
+            transforms.push_back(trsf);
+        }
+        return pattern(shape, transforms);
+    }
+
+    static ShapeResult circularPattern(const TopoDS_Shape& shape, const Ax1& axis, double angleStep, int count)
+    {
+        std::vector<gp_Trsf> transforms;
+        for (int i = 0; i < count; i++) {
+            gp_Trsf trsf;
+            trsf.SetRotation(Ax1::toAx1(axis), angleStep * i);
+            transforms.push_back(trsf);
+        }
+        return pattern(shape, transforms);
+    }
+
+    /// @brief instances at equal arc length along path (an edge or a wire), from its start to its end; on a closed
+    /// path they are spread over the whole loop without doubling up at the start
+    static ShapeResult curvePattern(const TopoDS_Shape& shape, const TopoDS_Shape& path, int count,
+        bool alignToTangent)
+    {
+        if (path.IsNull()) {
+            return ShapeResult { TopoDS_Shape(), false, "Path is null" };
+        }
+
+        TopoDS_Wire wire;
+        if (path.ShapeType() == TopAbs_EDGE) {
+            wire = BRepBuilderAPI_MakeWire(TopoDS::Edge(path));
+        } else if (path.ShapeType() == TopAbs_WIRE) {
+            wire = TopoDS::Wire(path);
+        } else {
+            return ShapeResult { TopoDS_Shape(), false, "Path must be an edge or a wire" };
+        }
+        if (count < 1) {
+            return ShapeResult { TopoDS_Shape(), false, "Count must be positive" };
+        }
+
+        BRepAdaptor_CompCurve curve(wire);
+        std::vector<double> parameters { curve.FirstParameter() };
+        if (count > 1) {
+            // on a closed path the end coincides with the start, so divide into one more point and drop the end
+            bool isClosed = BRep_Tool::IsClosed(wire);
+            GCPnts_UniformAbscissa abscissa(curve, isClosed ? count + 1 : count, curve.FirstParameter(),
+                curve.LastParameter());
+            if (!abscissa.IsDone()) {
+                return ShapeResult { TopoDS_Shape(), false, "Failed to divide the path" };
+            }
+            parameters.clear();
+            for (int i = 1; i <= std::min(count, abscissa.NbPoints()); i++) {
+                parameters.push_back(abscissa.Parameter(i));
+            }
+        }
+
+        gp_Pnt origin;
+        gp_Vec originTangent;
+        curve.D1(parameters.front(), origin, originTangent);
+        std::vector<gp_Trsf> transforms;
+        for (double parameter : parameters) {
+            gp_Pnt point;
+            gp_Vec tangent;
+            curve.D1(parameter, point, tangent);
+
+            gp_Quaternion rotation;
+            if (alignToTangent && originTangent.Magnitude() > gp::Resolution()
+                && tangent.Magnitude() > gp::Resolution()) {
+                rotation.SetRotation(originTangent, tangent);
+            }
+            gp_Trsf toOrigin, rotate, toPoint;
+            toOrigin.SetTranslation(origin, gp_Pnt(0, 0, 0));
+            rotate.SetRotation(rotation);
+            toPoint.SetTranslation(gp_Pnt(0, 0, 0), point);
+            transforms.push_back(toPoint * rotate * toOrigin);
+        }
+        return pattern(shape, transforms);
+    }
+
     static ShapeResult fillet(const TopoDS_Shape& shape, const NumberArray& edges, double radius)
     {
-        std::vector<int> edgeVec = vecFromJSArray<int>(edges);
+        return filletEdges(shape, vecFromJSArray<int>(edges), radius);
+    }
 
-        TopTools_IndexedMapOfShape edgeMap;
+    static ShapeResult filletIndexed(const TopologyIndex& index, const NumberArray& edges, double radius)
+    {
+        return filletEdges(index.shape(), index.map(TopAbs_EDGE), vecFromJSArray<int>(edges), radius);
+    }
+
+    static ShapeResult filletEdges(const TopoDS_Shape& shape, const std::vector<int>& edgeVec, double radius)
+    {
+        ArenaScope arena;
+        TopTools_IndexedMapOfShape edgeMap(1, MemoryArena::allocator());
         TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+        return filletEdges(shape, edgeMap, edgeVec, radius);
+    }
 
+    static ShapeResult filletEdges(const TopoDS_Shape& shape, const TopTools_IndexedMapOfShape& edgeMap,
+        const std::vector<int>& edgeVec, double radius)
+    {
         BRepFilletAPI_MakeFillet makeFillet(shape);
         for (auto edge : edgeVec) {
             makeFillet.Add(radius, TopoDS::Edge(edgeMap.FindKey(edge + 1)));
@@ -514,11 +858,25 @@ public:
 
     static ShapeResult chamfer(const TopoDS_Shape& shape, const NumberArray& edges, double distance)
     {
-        std::vector<int> edgeVec = vecFromJSArray<int>(edges);
+        return chamferEdges(shape, vecFromJSArray<int>(edges), distance);
+    }
 
-        TopTools_IndexedMapOfShape edgeMap;
+    static ShapeResult chamferIndexed(const TopologyIndex& index, const NumberArray& edges, double distance)
+    {
+        return chamferEdges(index.shape(), index.map(TopAbs_EDGE), vecFromJSArray<int>(edges), distance);
+    }
+
+    static ShapeResult chamferEdges(const TopoDS_Shape& shape, const std::vector<int>& edgeVec, double distance)
+    {
+        ArenaScope arena;
+        TopTools_IndexedMapOfShape edgeMap(1, MemoryArena::allocator());
         TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+        return chamferEdges(shape, edgeMap, edgeVec, distance);
+    }
 
+    static ShapeResult chamferEdges(const TopoDS_Shape& shape, const TopTools_IndexedMapOfShape& edgeMap,
+        const std::vector<int>& edgeVec, double distance)
+    {
         BRepFilletAPI_MakeChamfer makeChamfer(shape);
         for (auto edge : edgeVec) {
             makeChamfer.Add(distance, TopoDS::Edge(edgeMap.FindKey(edge + 1)));
@@ -569,6 +927,530 @@ public:
     }
 };
 
+/// @brief General-fuse based boolean: all arguments and tools are intersected once in the constructor, after
+/// which any combination of the split cells can be selected without recomputing intersections.
+class CellsBuilder {
+private:
+    BOPAlgo_CellsBuilder builder;
+    TopTools_ListOfShape arguments;
+    TopTools_ListOfShape tools;
+
+    ShapeResult result(const char* error)
+    {
+        if (builder.HasErrors()) {
+            return ShapeResult { TopoDS_Shape(), false, error };
+        }
+        return ShapeResult { builder.Shape(), true, "" };
+    }
+
+    template <typename F> ShapeResult select(F addCells)
+    {
+        builder.RemoveAllFromResult();
+        addCells();
+        builder.RemoveInternalBoundaries();
+        return result("Failed to select cells");
+    }
+
+public:
+    CellsBuilder(const ShapeArray& argumentArray, const ShapeArray& toolArray, const BooleanOptions& options)
+        : arguments(shapeArrayToListOfShape(argumentArray))
+        , tools(shapeArrayToListOfShape(toolArray))
+    {
+        TopTools_ListOfShape allShapes;
+        for (const auto& shape : arguments) {
+            allShapes.Append(shape);
+        }
+        for (const auto& shape : tools) {
+            allShapes.Append(shape);
+        }
+
+        builder.SetArguments(allShapes);
+        builder.SetRunParallel(options.parallel);
+        builder.SetUseOBB(options.useOBB);
+        if (options.fuzzyValue > 0) {
+            builder.SetFuzzyValue(options.fuzzyValue);
+        }
+        builder.SetGlue(options.glue);
+        builder.SetNonDestructive(options.nonDestructive);
+        builder.Perform();
+    }
+
+    bool isDone() const
+    {
+        return !builder.HasErrors();
+    }
+
+    ShapeResult allParts()
+    {
+        if (builder.HasErrors()) {
+            return ShapeResult { TopoDS_Shape(), false, "Failed to build general fuse" };
+        }
+        return ShapeResult { builder.GetAllParts(), true, "" };
+    }
+
+    ShapeResult selectUnion()
+    {
+        return select([this]() { builder.AddAllToResult(1, false); });
+    }
+
+    ShapeResult selectDifference()
+    {
+        return select([this]() {
+            for (const auto& argument : arguments) {
+                TopTools_ListOfShape take;
+                take.Append(argument);
+                builder.AddToResult(take, tools, 1, false);
+            }
+        });
+    }
+
+    ShapeResult selectIntersection()
+    {
+        return select([this]() {
+            for (const auto& argument : arguments) {
+                for (const auto& tool : tools) {
+                    TopTools_ListOfShape take;
+                    take.Append(argument);
+                    take.Append(tool);
+                    builder.AddToResult(take, TopTools_ListOfShape(), 1, false);
+                }
+            }
+        });
+    }
+
+    ShapeResult addToResult(const ShapeArray& take, const ShapeArray& avoid, int material)
+    {
+        builder.AddToResult(shapeArrayToListOfShape(take), shapeArrayToListOfShape(avoid), material, false);
+        return result("Failed to add cells");
+    }
+
+    ShapeResult removeFromResult(const ShapeArray& take, const ShapeArray& avoid)
+    {
+        builder.RemoveFromResult(shapeArrayToListOfShape(take), shapeArrayToListOfShape(avoid));
+        return result("Failed to remove cells");
+    }
+
+    ShapeResult removeAllFromResult()
+    {
+        builder.RemoveAllFromResult();
+        return result("Failed to clear cells");
+    }
+
+    ShapeResult removeInternalBoundaries()
+    {
+        builder.RemoveInternalBoundaries();
+        return result("Failed to remove internal boundaries");
+    }
+};
+
+enum class FeatureType {
+    /// @brief leaf node holding a shape supplied by the caller (sketch edges, imported bodies...)
+    Shape,
+    /// @brief inputs: edges (or shapes containing edges)
+    Wire,
+    /// @brief inputs: outer wire followed by hole wires
+    Face,
+    /// @brief inputs: profile; numbers: x, y, z
+    Prism,
+    /// @brief inputs: profile; numbers: location x, y, z, direction x, y, z, angle
+    Revolve,
+    /// @brief inputs: argument followed by tools
+    Fuse,
+    Cut,
+    Common,
+    /// @brief inputs: shape; numbers: radius (distance), edge index...
+    Fillet,
+    Chamfer,
+};
+
+struct FeatureStatistics {
+    int evaluations;
+    int cacheHits;
+    double lastMilliseconds;
+    double totalMilliseconds;
+};
+
+/// @brief Records factory operations as a DAG of nodes. Each node result is memoized by a hash of its type,
+/// parameters and input hashes; edits only mark the edited node and its downstream nodes dirty, and a dirty
+/// node whose inputs hash to a previously seen key reuses that result instead of rebuilding it, once the stored
+/// signature confirms the inputs really are the same.
+class FeatureGraph {
+private:
+    /// @brief everything compute reads. The key alone could collide, e.g. when a new shape reuses the address of
+    /// an evicted one, so a result is only reused when the signatures are equal as well.
+    struct Signature {
+        FeatureType type;
+        std::vector<double> numbers;
+        /// @brief the leaf shape, then the input result shapes
+        std::vector<TopoDS_Shape> shapes;
+        /// @brief input errors, empty for the inputs that succeeded
+        std::vector<std::string> errors;
+
+        bool operator==(const Signature& other) const
+        {
+            if (type != other.type || numbers.size() != other.numbers.size() || shapes.size() != other.shapes.size()
+                || errors != other.errors) {
+                return false;
+            }
+            if (!numbers.empty()
+                && std::memcmp(numbers.data(), other.numbers.data(), numbers.size() * sizeof(double)) != 0) {
+                return false;
+            }
+            for (size_t i = 0; i < shapes.size(); i++) {
+                if (!shapes[i].IsEqual(other.shapes[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    struct MemoEntry {
+        Signature signature;
+        ShapeResult result;
+    };
+
+    struct FeatureNode {
+        FeatureType type;
+        std::vector<int> inputs;
+        std::vector<double> numbers;
+        TopoDS_Shape shape;
+        std::vector<int> dependents;
+        bool dirty;
+        bool hasResult;
+        uint64_t key;
+        Signature signature;
+        ShapeResult result;
+        FeatureStatistics statistics;
+    };
+
+    std::vector<FeatureNode> nodes;
+    std::unordered_map<uint64_t, MemoEntry> memo;
+    std::deque<uint64_t> memoOrder;
+    size_t cacheCapacity = 64;
+
+    static uint64_t combine(uint64_t seed, uint64_t value)
+    {
+        uint64_t hash = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+        return hash ^ (hash >> 31);
+    }
+
+    bool isValid(int id) const
+    {
+        return id >= 0 && id < static_cast<int>(nodes.size());
+    }
+
+    void markDirty(int id)
+    {
+        // a dirty node always has dirty dependents, so the walk can stop there
+        if (nodes[id].dirty) {
+            return;
+        }
+        nodes[id].dirty = true;
+        for (int dependent : nodes[id].dependents) {
+            markDirty(dependent);
+        }
+    }
+
+    void remember(uint64_t key, const Signature& signature, const ShapeResult& result)
+    {
+        if (cacheCapacity == 0) {
+            return;
+        }
+        auto it = memo.find(key);
+        if (it != memo.end()) {
+            it->second = MemoEntry { signature, result };
+            return;
+        }
+        while (memo.size() >= cacheCapacity && !memoOrder.empty()) {
+            memo.erase(memoOrder.front());
+            memoOrder.pop_front();
+        }
+        memo.emplace(key, MemoEntry { signature, result });
+        memoOrder.push_back(key);
+    }
+
+    uint64_t computeKey(const FeatureNode& node) const
+    {
+        uint64_t key = combine(0, static_cast<uint64_t>(node.type));
+        if (node.type == FeatureType::Shape) {
+            key = combine(key, std::hash<TopoDS_Shape> {}(node.shape));
+            key = combine(key, static_cast<uint64_t>(node.shape.Orientation()));
+        }
+        for (double number : node.numbers) {
+            uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            key = combine(key, bits);
+        }
+        for (int input : node.inputs) {
+            key = combine(key, nodes[input].key);
+        }
+        return key;
+    }
+
+    Signature signatureOf(const FeatureNode& node) const
+    {
+        Signature signature { node.type, node.numbers, {}, {} };
+        if (node.type == FeatureType::Shape) {
+            signature.shapes.push_back(node.shape);
+        }
+        for (int input : node.inputs) {
+            signature.shapes.push_back(nodes[input].result.shape);
+            signature.errors.push_back(nodes[input].result.isOk ? "" : nodes[input].result.error);
+        }
+        return signature;
+    }
+
+    ShapeResult compute(const FeatureNode& node) const
+    {
+        std::vector<TopoDS_Shape> inputs;
+        for (int input : node.inputs) {
+            const auto& result = nodes[input].result;
+            if (!result.isOk) {
+                return ShapeResult { TopoDS_Shape(), false, "Input feature failed: " + result.error };
+            }
+            inputs.push_back(result.shape);
+        }
+
+        const auto& n = node.numbers;
+        switch (node.type) {
+        case FeatureType::Shape:
+            return ShapeResult { node.shape, !node.shape.IsNull(), node.shape.IsNull() ? "Null shape" : "" };
+        case FeatureType::Wire: {
+            std::vector<TopoDS_Edge> edges;
+            for (const auto& input : inputs) {
+                for (TopExp_Explorer explorer(input, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+                    edges.push_back(TopoDS::Edge(explorer.Current()));
+                }
+            }
+            return ShapeFactory::wireFromEdges(edges);
+        }
+        case FeatureType::Face: {
+            std::vector<TopoDS_Wire> wires;
+            for (const auto& input : inputs) {
+                for (TopExp_Explorer explorer(input, TopAbs_WIRE); explorer.More(); explorer.Next()) {
+                    wires.push_back(TopoDS::Wire(explorer.Current()));
+                }
+            }
+            return ShapeFactory::faceFromWires(wires);
+        }
+        case FeatureType::Prism:
+            if (inputs.size() != 1 || n.size() != 3) {
+                return ShapeResult { TopoDS_Shape(), false, "Prism requires 1 input and 3 numbers" };
+            }
+            return ShapeFactory::prism(inputs[0], Vector3 { n[0], n[1], n[2] });
+        case FeatureType::Revolve:
+            if (inputs.size() != 1 || n.size() != 7) {
+                return ShapeResult { TopoDS_Shape(), false, "Revolve requires 1 input and 7 numbers" };
+            }
+            return ShapeFactory::revolve(inputs[0], Ax1 { Vector3 { n[0], n[1], n[2] }, Vector3 { n[3], n[4], n[5] } },
+                n[6]);
+        case FeatureType::Fuse:
+        case FeatureType::Cut:
+        case FeatureType::Common:
+            return computeBoolean(node.type, inputs);
+        case FeatureType::Fillet:
+        case FeatureType::Chamfer:
+            return computeEdgeFeature(node.type, inputs, n);
+        }
+        return ShapeResult { TopoDS_Shape(), false, "Unknown feature type" };
+    }
+
+    static ShapeResult computeBoolean(FeatureType type, const std::vector<TopoDS_Shape>& inputs)
+    {
+        if (inputs.size() < 2) {
+            return ShapeResult { TopoDS_Shape(), false, "Boolean requires an argument and at least 1 tool" };
+        }
+
+        TopTools_ListOfShape args, tools;
+        args.Append(inputs[0]);
+        for (size_t i = 1; i < inputs.size(); i++) {
+            tools.Append(inputs[i]);
+        }
+        // memoized results are shared with other nodes, so the inputs must never be modified
+        BooleanOptions options = { .parallel = true,
+            .useOBB = false,
+            .fuzzyValue = 0,
+            .glue = BOPAlgo_GlueOff,
+            .nonDestructive = true };
+        BOPAlgo_Operation operation = BOPAlgo_COMMON;
+        if (type == FeatureType::Fuse) {
+            operation = BOPAlgo_FUSE;
+        } else if (type == FeatureType::Cut) {
+            operation = BOPAlgo_CUT;
+        }
+        return ShapeFactory::booleanOperate(operation, args, tools, options);
+    }
+
+    static ShapeResult computeEdgeFeature(FeatureType type, const std::vector<TopoDS_Shape>& inputs,
+        const std::vector<double>& numbers)
+    {
+        if (inputs.size() != 1 || numbers.size() < 2) {
+            return ShapeResult { TopoDS_Shape(), false, "Fillet/chamfer requires 1 input, a size and edge indices" };
+        }
+
+        TopTools_IndexedMapOfShape edgeMap;
+        TopExp::MapShapes(inputs[0], TopAbs_EDGE, edgeMap);
+        std::vector<int> edges;
+        for (size_t i = 1; i < numbers.size(); i++) {
+            int edge = static_cast<int>(numbers[i]);
+            if (edge < 0 || edge >= edgeMap.Extent()) {
+                return ShapeResult { TopoDS_Shape(), false, "Edge index out of range" };
+            }
+            edges.push_back(edge);
+        }
+
+        return type == FeatureType::Fillet ? ShapeFactory::filletEdges(inputs[0], edgeMap, edges, numbers[0])
+                                           : ShapeFactory::chamferEdges(inputs[0], edgeMap, edges, numbers[0]);
+    }
+
+    const ShapeResult& evaluateNode(int id)
+    {
+        auto& node = nodes[id];
+        if (!node.dirty) {
+            node.statistics.cacheHits++;
+            return node.result;
+        }
+
+        for (int input : node.inputs) {
+            evaluateNode(input);
+        }
+        node.dirty = false;
+
+        uint64_t key = computeKey(node);
+        auto signature = signatureOf(node);
+        if (node.hasResult && key == node.key && signature == node.signature) {
+            node.statistics.cacheHits++;
+            return node.result;
+        }
+        node.key = key;
+        node.signature = signature;
+        node.hasResult = true;
+
+        auto it = memo.find(key);
+        if (it != memo.end() && it->second.signature == signature) {
+            node.statistics.cacheHits++;
+            node.result = it->second.result;
+            return node.result;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        node.result = compute(node);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        node.statistics.evaluations++;
+        node.statistics.lastMilliseconds = milliseconds;
+        node.statistics.totalMilliseconds += milliseconds;
+        remember(key, node.signature, node.result);
+        return node.result;
+    }
+
+    int addNode(FeatureType type, std::vector<int>&& inputs, std::vector<double>&& numbers, const TopoDS_Shape& shape)
+    {
+        int id = nodes.size();
+        for (int input : inputs) {
+            if (!isValid(input)) {
+                return -1;
+            }
+        }
+
+        nodes.push_back(FeatureNode { .type = type,
+            .inputs = std::move(inputs),
+            .numbers = std::move(numbers),
+            .shape = shape,
+            .dependents = {},
+            .dirty = true,
+            .hasResult = false,
+            .key = 0,
+            .signature = Signature(),
+            .result = ShapeResult { TopoDS_Shape(), false, "Not evaluated" },
+            .statistics = FeatureStatistics() });
+        for (int input : nodes[id].inputs) {
+            nodes[input].dependents.push_back(id);
+        }
+        return id;
+    }
+
+public:
+    /// @brief returns the node id, or -1 if an input id is invalid
+    int addShape(const TopoDS_Shape& shape)
+    {
+        return addNode(FeatureType::Shape, {}, {}, shape);
+    }
+
+    /// @brief inputs must reference existing nodes, which keeps the graph acyclic
+    int addFeature(FeatureType type, const NumberArray& inputs, const NumberArray& numbers)
+    {
+        return addNode(type, vecFromJSArray<int>(inputs), vecFromJSArray<double>(numbers), TopoDS_Shape());
+    }
+
+    bool setShape(int id, const TopoDS_Shape& shape)
+    {
+        if (!isValid(id) || nodes[id].type != FeatureType::Shape) {
+            return false;
+        }
+        nodes[id].shape = shape;
+        markDirty(id);
+        return true;
+    }
+
+    bool setNumbers(int id, const NumberArray& numbers)
+    {
+        if (!isValid(id)) {
+            return false;
+        }
+        nodes[id].numbers = vecFromJSArray<double>(numbers);
+        markDirty(id);
+        return true;
+    }
+
+    ShapeResult evaluate(int id)
+    {
+        if (!isValid(id)) {
+            return ShapeResult { TopoDS_Shape(), false, "Invalid feature id" };
+        }
+        return evaluateNode(id);
+    }
+
+    bool isDirty(int id) const
+    {
+        return isValid(id) && nodes[id].dirty;
+    }
+
+    FeatureStatistics nodeStatistics(int id) const
+    {
+        return isValid(id) ? nodes[id].statistics : FeatureStatistics();
+    }
+
+    FeatureStatistics totalStatistics() const
+    {
+        FeatureStatistics total = FeatureStatistics();
+        for (const auto& node : nodes) {
+            total.evaluations += node.statistics.evaluations;
+            total.cacheHits += node.statistics.cacheHits;
+            total.lastMilliseconds += node.statistics.lastMilliseconds;
+            total.totalMilliseconds += node.statistics.totalMilliseconds;
+        }
+        return total;
+    }
+
+    int size() const
+    {
+        return nodes.size();
+    }
+
+    /// @brief number of results kept for keys that are no longer current (0 disables reuse across edits)
+    void setCacheCapacity(int capacity)
+    {
+        cacheCapacity = std::max(capacity, 0);
+        while (memo.size() > cacheCapacity && !memoOrder.empty()) {
+            memo.erase(memoOrder.front());
+            memoOrder.pop_front();
+        }
+    }
+};
+
 EMSCRIPTEN_BINDINGS(ShapeFactory)
 {
     class_<ShapeResult>("ShapeResult")
@@ -576,6 +1458,14 @@ EMSCRIPTEN_BINDINGS(ShapeFactory)
         .property("isOk", &ShapeResult::isOk)
         .property("error", &ShapeResult::error);
 
+    // BooleanOptions：布尔运算加速选项（并行、OBB 预过滤、模糊容差、粘合模式、非破坏模式）
+    value_object<BooleanOptions>("BooleanOptions")
+        .field("parallel", &BooleanOptions::parallel)
+        .field("useOBB", &BooleanOptions::useOBB)
+        .field("fuzzyValue", &BooleanOptions::fuzzyValue)
+        .field("glue", &BooleanOptions::glue)
+        .field("nonDestructive", &BooleanOptions::nonDestructive);
+
     class_<ShapeFactory>("ShapeFactory")
         // 创建长方体：在指定平面上创建面并沿法线方向挤出形成实体
         .class_function("box", &ShapeFactory::box)
@@ -586,6 +1476,14 @@ EMSCRIPTEN_BINDINGS(ShapeFactory)
         // 创建球体：在指定中心与半径处生成球体实体
         .class_function("sphere", &ShapeFactory::sphere)
 
+        // 批量创建基本体：records 为 Float64Array，每 13 个数描述一个基本体
+        // （类型 PrimitiveType、位置 xyz、方向 xyz、x 方向 xyz、3 个尺寸），有线程时并行构建
+        // - primitivesCompound(records) -> ShapeResult：全部放入一个 Compound，任一失败则返回错误
+        // - primitives(records) -> ShapeArray：逐个返回，失败的位置为空形状
+        // 长度不是 13 的整数倍时，末尾不完整的记录按失败处理
+        .class_function("primitivesCompound", &ShapeFactory::primitivesCompound)
+        .class_function("primitives", &ShapeFactory::primitives)
+
         // 创建椭球：通过缩放单位球并应用变换得到椭球（使用几何变换）
         .class_function("ellipsoid", &ShapeFactory::ellipsoid)
 
@@ -658,18 +1556,104 @@ EMSCRIPTEN_BINDINGS(ShapeFactory)
         // 布尔运算（并集）：对多个 shape 执行 Fuse（合并）操作
         .class_function("booleanFuse", &ShapeFactory::booleanFuse)
 
+        // 带选项的布尔运算（交/差/并）：通过 BooleanOptions 开启并行、OBB、模糊容差与粘合等加速手段
+        .class_function("booleanCommonWithOptions", &ShapeFactory::booleanCommonWithOptions)
+        .class_function("booleanCutWithOptions", &ShapeFactory::booleanCutWithOptions)
+        .class_function("booleanFuseWithOptions", &ShapeFactory::booleanFuseWithOptions)
+
         // 合并：把若干 shape 组装成一个 Compound（不做布尔合并）
         .class_function("combine", &ShapeFactory::combine)
 
+        // 阵列：返回同一 TShape 在不同 TopLoc_Location 下的引用组成的 Compound（几何共享，网格化与序列化只保留一份）
+        // - linearPattern(shape, step, count)：沿 step 向量等距阵列
+        // - circularPattern(shape, axis, angleStep, count)：绕轴按 angleStep（弧度）阵列
+        // - curvePattern(shape, path, count, alignToTangent)：沿边或线等弧长阵列，可按切向旋转
+        .class_function("linearPattern", &ShapeFactory::linearPattern)
+        .class_function("circularPattern", &ShapeFactory::circularPattern)
+        .class_function("curvePattern", &ShapeFactory::curvePattern)
+
         // 倒角 / 圆角（fillet）：沿指定的边索引执行圆角处理，返回处理后的形状
         .class_function("fillet", &ShapeFactory::fillet)
 
         // 倒棱（chamfer）：沿指定边索引执行倒棱处理，返回处理后的形状
         .class_function("chamfer", &ShapeFactory::chamfer)
 
+        // filletIndexed / chamferIndexed：同上，但使用预先构建的 TopologyIndex（边序号与 index.indexOf 一致），不再重建边映射
+        .class_function("filletIndexed", &ShapeFactory::filletIndexed)
+        .class_function("chamferIndexed", &ShapeFactory::chamferIndexed)
+
         // 放样（loft）：根据多个截面通过 ThruSections 构造实体或壳，支持实心/生成规则/连续性选项
         .class_function("loft", &ShapeFactory::loft)
 
         // 曲线投影：将曲线投影到目标面上（沿给定方向），返回投影结果 shape
         .class_function("curveProjection", &ShapeFactory::curveProjection);
+
+    // CellsBuilder：基于 BOPAlgo_CellsBuilder 的通用融合布尔。构造时对 args 与 tools 一次性求交，
+    // 之后可反复选择并集/差集/交集或任意单元组合而无需重新求交（适合布尔对话框中反复调整选择）
+    class_<CellsBuilder>("CellsBuilder")
+        .constructor<ShapeArray, ShapeArray, BooleanOptions>()
+        // isDone()：通用融合是否成功
+        .function("isDone", &CellsBuilder::isDone)
+        // allParts()：返回所有拆分后的单元（用于预览/拾取）
+        .function("allParts", &CellsBuilder::allParts)
+        // selectUnion / selectDifference / selectIntersection：重置选择并返回 args 与 tools 的并/差/交结果
+        .function("selectUnion", &CellsBuilder::selectUnion)
+        .function("selectDifference", &CellsBuilder::selectDifference)
+        .function("selectIntersection", &CellsBuilder::selectIntersection)
+        // addToResult(take, avoid, material)：加入位于所有 take 内且不在任何 avoid 内的单元，material 相同的单元可合并边界
+        .function("addToResult", &CellsBuilder::addToResult)
+        // removeFromResult(take, avoid)：从结果中移除对应单元
+        .function("removeFromResult", &CellsBuilder::removeFromResult)
+        // removeAllFromResult()：清空当前选择
+        .function("removeAllFromResult", &CellsBuilder::removeAllFromResult)
+        // removeInternalBoundaries()：合并相同 material 单元之间的内部边界
+        .function("removeInternalBoundaries", &CellsBuilder::removeInternalBoundaries);
+
+    // PrimitiveType：批量基本体记录中的类型码（Box / Cylinder / Sphere / Cone）
+    enum_<PrimitiveType>("PrimitiveType")
+        .value("Box", PrimitiveType::Box)
+        .value("Cylinder", PrimitiveType::Cylinder)
+        .value("Sphere", PrimitiveType::Sphere)
+        .value("Cone", PrimitiveType::Cone);
+
+    // FeatureType：特征图节点类型（形状叶子 / 线 / 面 / 拉伸 / 旋转 / 布尔 / 圆角 / 倒角）
+    enum_<FeatureType>("FeatureType")
+        .value("Shape", FeatureType::Shape)
+        .value("Wire", FeatureType::Wire)
+        .value("Face", FeatureType::Face)
+        .value("Prism", FeatureType::Prism)
+        .value("Revolve", FeatureType::Revolve)
+        .value("Fuse", FeatureType::Fuse)
+        .value("Cut", FeatureType::Cut)
+        .value("Common", FeatureType::Common)
+        .value("Fillet", FeatureType::Fillet)
+        .value("Chamfer", FeatureType::Chamfer);
+
+    // FeatureStatistics：节点（或整图）的计算次数、缓存命中次数与耗时（毫秒）
+    value_object<FeatureStatistics>("FeatureStatistics")
+        .field("evaluations", &FeatureStatistics::evaluations)
+        .field("cacheHits", &FeatureStatistics::cacheHits)
+        .field("lastMilliseconds", &FeatureStatistics::lastMilliseconds)
+        .field("totalMilliseconds", &FeatureStatistics::totalMilliseconds);
+
+    // FeatureGraph：参数化特征图。节点记录工厂操作（类型、数值参数、输入节点），结果按输入哈希缓存，
+    // 修改参数后只重算受影响的下游节点
+    class_<FeatureGraph>("FeatureGraph")
+        .constructor<>()
+        // addShape(shape) -> id：添加形状叶子节点（如草图边）
+        .function("addShape", &FeatureGraph::addShape)
+        // addFeature(type, inputs, numbers) -> id：添加操作节点，输入必须是已存在的节点，失败返回 -1
+        .function("addFeature", &FeatureGraph::addFeature)
+        // setShape / setNumbers：修改叶子形状或数值参数，并将该节点及下游标记为脏
+        .function("setShape", &FeatureGraph::setShape)
+        .function("setNumbers", &FeatureGraph::setNumbers)
+        // evaluate(id) -> ShapeResult：按需计算节点（仅重算脏节点）
+        .function("evaluate", &FeatureGraph::evaluate)
+        .function("isDirty", &FeatureGraph::isDirty)
+        // nodeStatistics / totalStatistics：单节点或整图的计算、命中与耗时统计
+        .function("nodeStatistics", &FeatureGraph::nodeStatistics)
+        .function("totalStatistics", &FeatureGraph::totalStatistics)
+        .function("size", &FeatureGraph::size)
+        // setCacheCapacity(n)：保留多少个历史结果用于撤销等场景的复用
+        .function("setCacheCapacity", &FeatureGraph::setCacheCapacity);
 }
\ No newline at end of file
@@ -1,22 +1,42 @@
 // Part of the Chili3d Project, under the AGPL-3.0 License.
 // See LICENSE file in the project root for full license information.
 
+#include <Extrema_ExtPC.hxx>
+#include <Extrema_ExtPS.hxx>
+#include <Extrema_GenLocateExtPS.hxx>
+#include <Extrema_LocateExtPC.hxx>
 #include <GCPnts_AbscissaPoint.hxx>
 #include <GCPnts_UniformAbscissa.hxx>
 #include <GeomAPI_ExtremaCurveCurve.hxx>
 #include <GeomAPI_ProjectPointOnCurve.hxx>
 #include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <GeomAdaptor_Curve.hxx>
+#include <GeomAdaptor_Surface.hxx>
+#include <GeomLib.hxx>
 #include <GeomLib_IsPlanarSurface.hxx>
 #include <GeomLib_Tool.hxx>
 #include <GeomProjLib.hxx>
+#include <Geom_Circle.hxx>
 #include <Geom_Curve.hxx>
+#include <Geom_CylindricalSurface.hxx>
+#include <Geom_Ellipse.hxx>
 #include <Geom_Line.hxx>
+#include <Geom_Plane.hxx>
+#include <Geom_RectangularTrimmedSurface.hxx>
+#include <Geom_SphericalSurface.hxx>
 #include <Geom_Surface.hxx>
 #include <Geom_TrimmedCurve.hxx>
+#include <Precision.hxx>
 #include <Standard_Handle.hxx>
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <optional>
+#include <vector>
 
 #include "shared.hpp"
 #include "utils.hpp"
@@ -34,6 +54,79 @@ private:
         return Vector3Array(val::array(points));
     }
 
+    static void evaluateLine(const gp_Lin& line, const std::vector<double>& parameters, int order,
+        std::vector<double>& result)
+    {
+        const gp_XYZ& o = line.Location().XYZ();
+        const gp_XYZ& d = line.Direction().XYZ();
+        size_t stride = 3 * (order + 1);
+        for (size_t i = 0; i < parameters.size(); i++) {
+            double t = parameters[i];
+            double* out = result.data() + i * stride;
+            out[0] = o.X() + t * d.X();
+            out[1] = o.Y() + t * d.Y();
+            out[2] = o.Z() + t * d.Z();
+            if (order > 0) {
+                out[3] = d.X();
+                out[4] = d.Y();
+                out[5] = d.Z();
+            }
+        }
+    }
+
+    /// @brief circles and ellipses: center + a cos(t) X + b sin(t) Y
+    static void evaluateConic(const gp_Ax2& position, double a, double b, const std::vector<double>& parameters,
+        int order, std::vector<double>& result)
+    {
+        const gp_XYZ& c = position.Location().XYZ();
+        gp_XYZ x = position.XDirection().XYZ() * a;
+        gp_XYZ y = position.YDirection().XYZ() * b;
+        size_t stride = 3 * (order + 1);
+        for (size_t i = 0; i < parameters.size(); i++) {
+            double cosT = std::cos(parameters[i]), sinT = std::sin(parameters[i]);
+            double* out = result.data() + i * stride;
+            out[0] = c.X() + cosT * x.X() + sinT * y.X();
+            out[1] = c.Y() + cosT * x.Y() + sinT * y.Y();
+            out[2] = c.Z() + cosT * x.Z() + sinT * y.Z();
+            if (order > 0) {
+                out[3] = cosT * y.X() - sinT * x.X();
+                out[4] = cosT * y.Y() - sinT * x.Y();
+                out[5] = cosT * y.Z() - sinT * x.Z();
+            }
+            if (order > 1) {
+                out[6] = c.X() - out[0];
+                out[7] = c.Y() - out[1];
+                out[8] = c.Z() - out[2];
+            }
+        }
+    }
+
+    static void evaluateGeneric(const Handle(Geom_Curve)& curve, const std::vector<double>& parameters, int order,
+        std::vector<double>& result)
+    {
+        // the adaptor keeps the B-spline span cache between neighbouring parameters
+        GeomAdaptor_Curve adaptor(curve);
+        size_t stride = 3 * (order + 1);
+        gp_Pnt point;
+        gp_Vec d1, d2;
+        for (size_t i = 0; i < parameters.size(); i++) {
+            double* out = result.data() + i * stride;
+            if (order == 0) {
+                adaptor.D0(parameters[i], point);
+            } else if (order == 1) {
+                adaptor.D1(parameters[i], point, d1);
+            } else {
+                adaptor.D2(parameters[i], point, d1, d2);
+            }
+            gp_XYZ values[] = { point.XYZ(), d1.XYZ(), d2.XYZ() };
+            for (int k = 0; k <= order; k++) {
+                out[k * 3] = values[k].X();
+                out[k * 3 + 1] = values[k].Y();
+                out[k * 3 + 2] = values[k].Z();
+            }
+        }
+    }
+
 public:
     static Handle_Geom_Line makeLine(const Vector3& start, const Vector3& dir)
     {
@@ -112,6 +205,34 @@ public:
         GeomAdaptor_Curve adaptorCurve(curve);
         return GCPnts_AbscissaPoint::Length(adaptorCurve);
     }
+
+    /// @brief Evaluates the curve at every parameter in one call. Each parameter writes x, y, z, followed by the
+    /// first (derivatives >= 1) and second (derivatives = 2) derivatives. Lines, circles and ellipses, also when
+    /// trimmed, use closed-form loops; other curves go through GeomAdaptor_Curve.
+    static Float64Array evaluate(const Geom_Curve* curve, const Float64Array& parameters, int derivatives)
+    {
+        auto values = convertJSArrayToNumberVector<double>(parameters);
+        int order = std::clamp(derivatives, 0, 2);
+        std::vector<double> result(values.size() * 3 * (order + 1), 0);
+
+        Handle(Geom_Curve) basis(curve);
+        while (basis->IsKind(STANDARD_TYPE(Geom_TrimmedCurve))) {
+            basis = Handle(Geom_TrimmedCurve)::DownCast(basis)->BasisCurve();
+        }
+        if (basis->IsKind(STANDARD_TYPE(Geom_Line))) {
+            evaluateLine(Handle(Geom_Line)::DownCast(basis)->Lin(), values, order, result);
+        } else if (basis->IsKind(STANDARD_TYPE(Geom_Circle))) {
+            auto circle = Handle(Geom_Circle)::DownCast(basis);
+            evaluateConic(circle->Position(), circle->Radius(), circle->Radius(), values, order, result);
+        } else if (basis->IsKind(STANDARD_TYPE(Geom_Ellipse))) {
+            auto ellipse = Handle(Geom_Ellipse)::DownCast(basis);
+            evaluateConic(ellipse->Position(), ellipse->MajorRadius(), ellipse->MinorRadius(), values, order,
+                result);
+        } else {
+            evaluateGeneric(Handle(Geom_Curve)(curve), values, order, result);
+        }
+        return toTypedArray<Float64Array>(result);
+    }
 };
 
 struct SurfaceBounds {
@@ -122,6 +243,117 @@ struct SurfaceBounds {
 };
 
 class Surface {
+private:
+    static void write(double* out, const gp_XYZ& value)
+    {
+        out[0] = value.X();
+        out[1] = value.Y();
+        out[2] = value.Z();
+    }
+
+    static void evaluatePlane(const gp_Ax3& position, const std::vector<double>& uvs, bool normals,
+        std::vector<double>& result)
+    {
+        const gp_XYZ& o = position.Location().XYZ();
+        const gp_XYZ& x = position.XDirection().XYZ();
+        const gp_XYZ& y = position.YDirection().XYZ();
+        gp_XYZ normal = x.Crossed(y);
+        size_t stride = normals ? 6 : 3;
+        for (size_t i = 0; i < uvs.size() / 2; i++) {
+            double u = uvs[i * 2], v = uvs[i * 2 + 1];
+            double* out = result.data() + i * stride;
+            out[0] = o.X() + u * x.X() + v * y.X();
+            out[1] = o.Y() + u * x.Y() + v * y.Y();
+            out[2] = o.Z() + u * x.Z() + v * y.Z();
+            if (normals) {
+                write(out + 3, normal);
+            }
+        }
+    }
+
+    /// @brief cylinders (sphere = false): o + r (cos u X + sin u Y) + v Z; spheres: o + r (cos v (cos u X +
+    /// sin u Y) + sin v Z). The normal is the radial direction, flipped for a left-handed position.
+    static void evaluateRevolved(const gp_Ax3& position, double radius, bool sphere, const std::vector<double>& uvs,
+        bool normals, std::vector<double>& result)
+    {
+        const gp_XYZ& o = position.Location().XYZ();
+        const gp_XYZ& x = position.XDirection().XYZ();
+        const gp_XYZ& y = position.YDirection().XYZ();
+        const gp_XYZ& z = position.Direction().XYZ();
+        double sign = position.Direct() ? 1 : -1;
+        size_t stride = normals ? 6 : 3;
+        for (size_t i = 0; i < uvs.size() / 2; i++) {
+            double u = uvs[i * 2], v = uvs[i * 2 + 1];
+            double cosU = std::cos(u), sinU = std::sin(u);
+            double cosV = sphere ? std::cos(v) : 1, sinV = sphere ? std::sin(v) : 0;
+            double height = sphere ? 0 : v;
+            double nx = cosV * (cosU * x.X() + sinU * y.X()) + sinV * z.X();
+            double ny = cosV * (cosU * x.Y() + sinU * y.Y()) + sinV * z.Y();
+            double nz = cosV * (cosU * x.Z() + sinU * y.Z()) + sinV * z.Z();
+            double* out = result.data() + i * stride;
+            out[0] = o.X() + radius * nx + height * z.X();
+            out[1] = o.Y() + radius * ny + height * z.Y();
+            out[2] = o.Z() + radius * nz + height * z.Z();
+            if (normals) {
+                out[3] = sign * nx;
+                out[4] = sign * ny;
+                out[5] = sign * nz;
+            }
+        }
+    }
+
+    static void evaluateGeneric(const Handle(Geom_Surface)& surface, const std::vector<double>& uvs, bool normals,
+        std::vector<double>& result)
+    {
+        GeomAdaptor_Surface adaptor(surface);
+        size_t stride = normals ? 6 : 3;
+        gp_Pnt point;
+        gp_Vec du, dv;
+        for (size_t i = 0; i < uvs.size() / 2; i++) {
+            double u = uvs[i * 2], v = uvs[i * 2 + 1];
+            double* out = result.data() + i * stride;
+            if (!normals) {
+                adaptor.D0(u, v, point);
+                write(out, point.XYZ());
+                continue;
+            }
+
+            adaptor.D1(u, v, point, du, dv);
+            write(out, point.XYZ());
+            gp_Vec normal = du.Crossed(dv);
+            if (normal.Magnitude() > gp::Resolution()) {
+                write(out + 3, normal.Normalized().XYZ());
+            } else {
+                // singular points such as the apex of a cone
+                gp_Dir estimated;
+                if (GeomLib::NormEstim(surface, gp_Pnt2d(u, v), Precision::Confusion(), estimated) <= 1) {
+                    write(out + 3, estimated.XYZ());
+                }
+            }
+        }
+    }
+
+    static Float64Array evaluateUVs(const Geom_Surface* surface, const std::vector<double>& uvs, bool normals)
+    {
+        std::vector<double> result(uvs.size() / 2 * (normals ? 6 : 3), 0);
+        Handle(Geom_Surface) basis(surface);
+        while (basis->IsKind(STANDARD_TYPE(Geom_RectangularTrimmedSurface))) {
+            basis = Handle(Geom_RectangularTrimmedSurface)::DownCast(basis)->BasisSurface();
+        }
+        if (basis->IsKind(STANDARD_TYPE(Geom_Plane))) {
+            evaluatePlane(Handle(Geom_Plane)::DownCast(basis)->Position(), uvs, normals, result);
+        } else if (basis->IsKind(STANDARD_TYPE(Geom_CylindricalSurface))) {
+            auto cylinder = Handle(Geom_CylindricalSurface)::DownCast(basis);
+            evaluateRevolved(cylinder->Position(), cylinder->Radius(), false, uvs, normals, result);
+        } else if (basis->IsKind(STANDARD_TYPE(Geom_SphericalSurface))) {
+            auto sphere = Handle(Geom_SphericalSurface)::DownCast(basis);
+            evaluateRevolved(sphere->Position(), sphere->Radius(), true, uvs, normals, result);
+        } else {
+            evaluateGeneric(Handle(Geom_Surface)(surface), uvs, normals, result);
+        }
+        return toTypedArray<Float64Array>(result);
+    }
+
 public:
     static Handle_Geom_Curve projectCurve(const Geom_Surface* surface, const Geom_Curve* curve)
     {
@@ -173,6 +405,308 @@ public:
         surface->Bounds(u1, u2, v1, v2);
         return SurfaceBounds { .u1 = u1, .u2 = u2, .v1 = v1, .v2 = v2 };
     }
+
+    /// @brief Evaluates the surface at u, v pairs in one call: x, y, z per pair, followed by the unit normal
+    /// (D1U ^ D1V) when normals is true. Planes, cylinders and spheres, also when trimmed, use closed-form loops.
+    static Float64Array evaluate(const Geom_Surface* surface, const Float64Array& uvs, bool normals)
+    {
+        return evaluateUVs(surface, convertJSArrayToNumberVector<double>(uvs), normals);
+    }
+
+    /// @brief evaluate on a uCount x vCount grid spanning the bounds, u varying fastest
+    static Float64Array evaluateGrid(const Geom_Surface* surface, const SurfaceBounds& grid, int uCount, int vCount,
+        bool normals)
+    {
+        std::vector<double> uvs;
+        uvs.reserve(static_cast<size_t>(std::max(uCount, 0)) * std::max(vCount, 0) * 2);
+        for (int j = 0; j < vCount; j++) {
+            double v = vCount > 1 ? grid.v1 + (grid.v2 - grid.v1) * j / (vCount - 1) : grid.v1;
+            for (int i = 0; i < uCount; i++) {
+                double u = uCount > 1 ? grid.u1 + (grid.u2 - grid.u1) * i / (uCount - 1) : grid.u1;
+                uvs.insert(uvs.end(), { u, v });
+            }
+        }
+        return evaluateUVs(surface, uvs, normals);
+    }
+};
+
+struct SurfaceProjection {
+    Vector3 point;
+    double u;
+    double v;
+    double distance;
+};
+
+/// @brief Whether a distance found by a warm-started local search may be the global minimum. A closer coarse sample
+/// proves that it is not. Unbounded ranges have no samples, there the local solution is only kept while the point
+/// stays within the previous distance of where it was, farther away another branch may have come closer.
+static bool mayBeGlobal(const std::vector<gp_Pnt>& samples, const gp_Pnt& pnt, double distance, double moved,
+    double previousDistance)
+{
+    if (samples.empty()) {
+        return moved <= previousDistance;
+    }
+    double bound = distance + Precision::Confusion();
+    return std::none_of(samples.begin(), samples.end(),
+        [&](const gp_Pnt& sample) { return pnt.SquareDistance(sample) < bound * bound; });
+}
+
+/// @brief Projects a moving point, e.g. while dragging, onto one curve. The extrema sampling is initialized once
+/// and each query starts a local search from the previous solution. The full search runs for the first query,
+/// after reset, when the local search fails or finds a maximum, and when a coarse sample of the curve is closer than
+/// the local minimum, i.e. the point has moved over to another branch. Like Curve.projectOrNearest, a closer curve
+/// end wins.
+class CurveProjector {
+    static constexpr int SAMPLES = 64;
+
+    Handle(Geom_Curve) curve;
+    GeomAdaptor_Curve adaptor;
+    double first;
+    double last;
+    Extrema_ExtPC extrema;
+    Extrema_LocateExtPC locator;
+    std::vector<gp_Pnt> samples;
+    bool hasPrevious = false;
+    gp_Pnt previousPoint;
+    ProjectPointResult previous { Vector3 { 0, 0, 0 }, 0, 0 };
+
+    std::optional<ProjectPointResult> locate(const gp_Pnt& pnt)
+    {
+        locator.Perform(pnt, previous.parameter);
+        if (!locator.IsDone() || !locator.IsMin()) {
+            return std::nullopt;
+        }
+
+        double parameter = locator.Point().Parameter();
+        double distance = std::sqrt(locator.SquareDistance());
+        if (parameter < first - Precision::PConfusion() || parameter > last + Precision::PConfusion()
+            || !mayBeGlobal(samples, pnt, distance, pnt.Distance(previousPoint), previous.distance)) {
+            return std::nullopt;
+        }
+        return ProjectPointResult { Vector3::fromPnt(locator.Point().Value()), distance, parameter };
+    }
+
+    std::optional<ProjectPointResult> search(const gp_Pnt& pnt)
+    {
+        extrema.Perform(pnt);
+        if (!extrema.IsDone()) {
+            return std::nullopt;
+        }
+
+        std::optional<ProjectPointResult> result;
+        for (int i = 1; i <= extrema.NbExt(); i++) {
+            double distance = std::sqrt(extrema.SquareDistance(i));
+            if (extrema.IsMin(i) && (!result.has_value() || distance < result->distance)) {
+                result = ProjectPointResult { Vector3::fromPnt(extrema.Point(i).Value()), distance,
+                    extrema.Point(i).Parameter() };
+            }
+        }
+        return result;
+    }
+
+    void closerEnd(const gp_Pnt& pnt, std::optional<ProjectPointResult>& result) const
+    {
+        for (double parameter : { first, last }) {
+            if (Precision::IsInfinite(parameter)) {
+                continue;
+            }
+            gp_Pnt end = adaptor.Value(parameter);
+            double distance = pnt.Distance(end);
+            if (!result.has_value() || distance < result->distance) {
+                result = ProjectPointResult { Vector3::fromPnt(end), distance, parameter };
+            }
+        }
+    }
+
+    std::optional<ProjectPointResult> projectPnt(const gp_Pnt& pnt)
+    {
+        std::optional<ProjectPointResult> result;
+        if (hasPrevious) {
+            result = locate(pnt);
+        }
+        if (!result.has_value()) {
+            result = search(pnt);
+        }
+        closerEnd(pnt, result);
+
+        hasPrevious = result.has_value();
+        if (hasPrevious) {
+            previous = result.value();
+            previousPoint = pnt;
+        }
+        return result;
+    }
+
+public:
+    CurveProjector(const Geom_Curve* curve)
+        : curve(curve)
+        , adaptor(this->curve)
+        , first(curve->FirstParameter())
+        , last(curve->LastParameter())
+    {
+        extrema.Initialize(adaptor, first, last);
+        locator.Initialize(adaptor, first, last, Precision::PConfusion());
+        if (!Precision::IsInfinite(first) && !Precision::IsInfinite(last)) {
+            for (int i = 0; i <= SAMPLES; i++) {
+                samples.push_back(adaptor.Value(first + (last - first) * i / SAMPLES));
+            }
+        }
+    }
+
+    CurveProjector(const CurveProjector&) = delete;
+    CurveProjector& operator=(const CurveProjector&) = delete;
+
+    /// @brief forgets the previous solution, e.g. when a new drag starts
+    void reset()
+    {
+        hasPrevious = false;
+    }
+
+    ProjectPointResult project(const Vector3& point)
+    {
+        auto result = projectPnt(Vector3::toPnt(point));
+        return result.value_or(ProjectPointResult { point, std::numeric_limits<double>::quiet_NaN(), 0 });
+    }
+
+    /// @brief projects the x, y, z triples in order, each warm-started from the previous one; writes x, y, z,
+    /// parameter and distance per point, NaN when a point could not be projected
+    Float64Array projectPoints(const Float64Array& points)
+    {
+        auto values = convertJSArrayToNumberVector<double>(points);
+        std::vector<double> result(values.size() / 3 * 5, std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < values.size() / 3; i++) {
+            auto projection = projectPnt(gp_Pnt(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+            if (projection.has_value()) {
+                const auto& p = projection.value();
+                double record[] = { p.point.x, p.point.y, p.point.z, p.parameter, p.distance };
+                std::copy(record, record + 5, result.begin() + i * 5);
+            }
+        }
+        return toTypedArray<Float64Array>(result);
+    }
+};
+
+/// @brief Surface counterpart of CurveProjector: the Extrema_ExtPS grid and the local Extrema_GenLocateExtPS are
+/// built once and every query starts from the previous u, v, checked against a coarse sample grid the same way.
+class SurfaceProjector {
+    static constexpr int SAMPLES = 16;
+
+    Handle(Geom_Surface) surface;
+    GeomAdaptor_Surface adaptor;
+    double u1, u2, v1, v2;
+    Extrema_ExtPS extrema;
+    Extrema_GenLocateExtPS locator;
+    std::vector<gp_Pnt> samples;
+    bool hasPrevious = false;
+    gp_Pnt previousPoint;
+    SurfaceProjection previous { Vector3 { 0, 0, 0 }, 0, 0, 0 };
+
+    bool inBounds(double u, double v) const
+    {
+        double tolerance = Precision::PConfusion();
+        return u >= u1 - tolerance && u <= u2 + tolerance && v >= v1 - tolerance && v <= v2 + tolerance;
+    }
+
+    std::optional<SurfaceProjection> locate(const gp_Pnt& pnt)
+    {
+        // the distance criteria minimizes the distance itself, the default only solves for an extremum
+        locator.Perform(pnt, previous.u, previous.v, true);
+        if (!locator.IsDone()) {
+            return std::nullopt;
+        }
+
+        double u, v;
+        locator.Point().Parameter(u, v);
+        double distance = std::sqrt(locator.SquareDistance());
+        if (!inBounds(u, v) || !mayBeGlobal(samples, pnt, distance, pnt.Distance(previousPoint), previous.distance)) {
+            return std::nullopt;
+        }
+        return SurfaceProjection { Vector3::fromPnt(locator.Point().Value()), u, v, distance };
+    }
+
+    std::optional<SurfaceProjection> search(const gp_Pnt& pnt)
+    {
+        extrema.Perform(pnt);
+        if (!extrema.IsDone()) {
+            return std::nullopt;
+        }
+
+        std::optional<SurfaceProjection> result;
+        for (int i = 1; i <= extrema.NbExt(); i++) {
+            double distance = std::sqrt(extrema.SquareDistance(i));
+            if (!result.has_value() || distance < result->distance) {
+                double u, v;
+                extrema.Point(i).Parameter(u, v);
+                result = SurfaceProjection { Vector3::fromPnt(extrema.Point(i).Value()), u, v, distance };
+            }
+        }
+        return result;
+    }
+
+    std::optional<SurfaceProjection> projectPnt(const gp_Pnt& pnt)
+    {
+        std::optional<SurfaceProjection> result;
+        if (hasPrevious) {
+            result = locate(pnt);
+        }
+        if (!result.has_value()) {
+            result = search(pnt);
+        }
+
+        hasPrevious = result.has_value();
+        if (hasPrevious) {
+            previous = result.value();
+            previousPoint = pnt;
+        }
+        return result;
+    }
+
+public:
+    SurfaceProjector(const Geom_Surface* surface)
+        : surface(surface)
+        , adaptor(this->surface)
+        , locator(adaptor)
+    {
+        surface->Bounds(u1, u2, v1, v2);
+        extrema.Initialize(adaptor, u1, u2, v1, v2, Precision::PConfusion(), Precision::PConfusion());
+        if (!Precision::IsInfinite(u1) && !Precision::IsInfinite(u2) && !Precision::IsInfinite(v1)
+            && !Precision::IsInfinite(v2)) {
+            for (int i = 0; i <= SAMPLES; i++) {
+                for (int j = 0; j <= SAMPLES; j++) {
+                    samples.push_back(adaptor.Value(u1 + (u2 - u1) * i / SAMPLES, v1 + (v2 - v1) * j / SAMPLES));
+                }
+            }
+        }
+    }
+
+    SurfaceProjector(const SurfaceProjector&) = delete;
+    SurfaceProjector& operator=(const SurfaceProjector&) = delete;
+
+    void reset()
+    {
+        hasPrevious = false;
+    }
+
+    std::optional<SurfaceProjection> project(const Vector3& point)
+    {
+        return projectPnt(Vector3::toPnt(point));
+    }
+
+    /// @brief like CurveProjector::projectPoints, writing x, y, z, u, v and distance per point
+    Float64Array projectPoints(const Float64Array& points)
+    {
+        auto values = convertJSArrayToNumberVector<double>(points);
+        std::vector<double> result(values.size() / 3 * 6, std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < values.size() / 3; i++) {
+            auto projection = projectPnt(gp_Pnt(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+            if (projection.has_value()) {
+                const auto& p = projection.value();
+                double record[] = { p.point.x, p.point.y, p.point.z, p.u, p.v, p.distance };
+                std::copy(record, record + 6, result.begin() + i * 6);
+            }
+        }
+        return toTypedArray<Float64Array>(result);
+    }
 };
 
 EMSCRIPTEN_BINDINGS(Geometry)
@@ -196,7 +730,9 @@ EMSCRIPTEN_BINDINGS(Geometry)
         // 计算曲线总长度（基于 GeomAdaptor_Curve）
         .class_function("curveLength", &Curve::curveLength, allow_raw_pointers())
         // 将给定三维点投影到曲线上并返回所有投影点坐标（可能多解）
-        .class_function("projects", &Curve::projects, allow_raw_pointers());
+        .class_function("projects", &Curve::projects, allow_raw_pointers())
+        // 批量计算曲线在一组参数处的点（derivatives 为 1/2 时附带一阶/二阶导数），返回 Float64Array
+        .class_function("evaluate", &Curve::evaluate, allow_raw_pointers());
 
     // SurfaceBounds：曲面参数范围的简单值对象（u1,u2,v1,v2）
     value_object<SurfaceBounds>("SurfaceBounds")
@@ -218,5 +754,38 @@ EMSCRIPTEN_BINDINGS(Geometry)
         // 查找曲面上距离点最近的点并返回该点及相关参数/距离信息
         .class_function("nearestPoint", &Surface::nearestPoint, allow_raw_pointers())
         // 获取曲面的参数范围（u1,u2,v1,v2）
-        .class_function("bounds", &Surface::bounds, allow_raw_pointers());
+        .class_function("bounds", &Surface::bounds, allow_raw_pointers())
+        // 批量计算曲面在一组 (u,v) 参数处的点（normals 为 true 时附带单位法向），返回 Float64Array
+        .class_function("evaluate", &Surface::evaluate, allow_raw_pointers())
+        // 在参数范围内按 uCount x vCount 网格批量计算点和法向（u 变化最快），返回 Float64Array
+        .class_function("evaluateGrid", &Surface::evaluateGrid, allow_raw_pointers());
+
+    // SurfaceProjection：点投影到曲面的结果（投影点、参数 u/v、距离）
+    value_object<SurfaceProjection>("SurfaceProjection")
+        .field("point", &SurfaceProjection::point)
+        .field("u", &SurfaceProjection::u)
+        .field("v", &SurfaceProjection::v)
+        .field("distance", &SurfaceProjection::distance);
+    // 注册 SurfaceProjection 的可选类型（投影失败时为空）
+    register_optional<SurfaceProjection>();
+
+    // CurveProjector：绑定到一条曲线的有状态投影器，缓存极值初始化并以上一次结果作为初值（用于拖拽）
+    class_<CurveProjector>("CurveProjector")
+        .constructor<const Geom_Curve*>(allow_raw_pointers())
+        // reset()：清除上一次的结果，下一次投影重新全局搜索
+        .function("reset", &CurveProjector::reset)
+        // project(point) -> ProjectPointResult：投影点到曲线，端点更近时返回端点（与 Curve.projectOrNearest 一致）
+        .function("project", &CurveProjector::project)
+        // projectPoints(points) -> Float64Array：按顺序批量投影 xyz 点，每点输出 x,y,z,parameter,distance
+        .function("projectPoints", &CurveProjector::projectPoints);
+
+    // SurfaceProjector：绑定到一个曲面的有状态投影器
+    class_<SurfaceProjector>("SurfaceProjector")
+        .constructor<const Geom_Surface*>(allow_raw_pointers())
+        // reset()：清除上一次的结果
+        .function("reset", &SurfaceProjector::reset)
+        // project(point) -> SurfaceProjection | undefined：投影点到曲面
+        .function("project", &SurfaceProjector::project)
+        // projectPoints(points) -> Float64Array：按顺序批量投影 xyz 点，每点输出 x,y,z,u,v,distance
+        .function("projectPoints", &SurfaceProjector::projectPoints);
 }
\ No newline at end of file
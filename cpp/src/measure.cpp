@@ -0,0 +1,284 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <BRepBndLib.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepGProp.hxx>
+#include <Bnd_Box.hxx>
+#include <GProp_GProps.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <TopoDS_Shape.hxx>
+#include <gp_Mat.hxx>
+#include <gp_Pnt.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "bounds.hpp"
+#include "mesher.hpp"
+#include "shared.hpp"
+#include "utils.hpp"
+
+using namespace emscripten;
+
+struct DistanceResult {
+    /// @brief i, j shape indices of every reported pair (i < j)
+    Int32Array pairs;
+    /// @brief minimum distance of every pair, 0 when the shapes touch or overlap
+    Float64Array distances;
+    /// @brief x, y, z on shape i followed by x, y, z on shape j for every pair
+    Float64Array points;
+    /// @brief 1 when the pair touches or interferes (distance within Precision::Confusion)
+    Uint8Array overlaps;
+};
+
+enum class MassPropertyMode {
+    /// @brief integrate the exact geometry; a positive tolerance bounds the relative error
+    Exact,
+    /// @brief integrate over a triangulation of the shape at the given deflection; an existing face triangulation
+    /// within that deflection is reused, and the faces are left as they were afterwards
+    Mesh,
+};
+
+struct MassProperties {
+    /// @brief total edge length per shape, shared edges counted once
+    Float64Array length;
+    Float64Array area;
+    /// @brief volume of the closed shells per shape, 0 for wires and open shells
+    Float64Array volume;
+    /// @brief x, y, z per shape, from the volume, or the area / length when there is none
+    Float64Array centroid;
+    /// @brief Ixx, Iyy, Izz, Ixy, Ixz, Iyz per shape, about the centroid
+    Float64Array inertia;
+    /// @brief relative error estimate of the exact integration per shape, 0 in Mesh mode or without tolerance
+    Float64Array error;
+};
+
+class Measure {
+private:
+    struct Candidate {
+        int first;
+        int second;
+        double distance;
+        gp_Pnt point1;
+        gp_Pnt point2;
+        bool isDone;
+    };
+
+    /// @brief Sweep along x over the boxes enlarged by the threshold; only pairs whose boxes are within the
+    /// threshold go to the exact test. A negative threshold keeps every pair.
+    static std::vector<Candidate> broadPhase(const std::vector<Bnd_Box>& boxes, double threshold)
+    {
+        std::vector<int> order(boxes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<double> xmin(boxes.size()), xmax(boxes.size());
+        for (size_t i = 0; i < boxes.size(); i++) {
+            double ymin, zmin, ymax, zmax;
+            boxes[i].Get(xmin[i], ymin, zmin, xmax[i], ymax, zmax);
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return xmin[a] < xmin[b]; });
+
+        std::vector<Candidate> candidates;
+        double reach = std::max(threshold, 0.0);
+        for (size_t a = 0; a < order.size(); a++) {
+            for (size_t b = a + 1; b < order.size(); b++) {
+                int i = order[a], j = order[b];
+                if (threshold >= 0 && xmin[j] - xmax[i] > reach) {
+                    break;
+                }
+                if (threshold >= 0 && boxes[i].Distance(boxes[j]) > reach) {
+                    continue;
+                }
+                candidates.push_back(Candidate { std::min(i, j), std::max(i, j), 0, gp_Pnt(), gp_Pnt(), false });
+            }
+        }
+        return candidates;
+    }
+
+    struct ShapeProperties {
+        double length;
+        double area;
+        double volume;
+        gp_Pnt centroid;
+        gp_Mat inertia;
+        double error;
+    };
+
+    static ShapeProperties shapeProperties(const TopoDS_Shape& shape, MassPropertyMode mode, double tolerance)
+    {
+        GProp_GProps linear, surface, volume;
+        double error = 0;
+        if (mode == MassPropertyMode::Exact && tolerance > 0) {
+            BRepGProp::LinearProperties(shape, linear, true);
+            error = std::max(error, BRepGProp::SurfaceProperties(shape, surface, tolerance, true));
+            error = std::max(error, BRepGProp::VolumeProperties(shape, volume, tolerance, true, true));
+        } else {
+            bool useTriangulation = mode == MassPropertyMode::Mesh;
+            BRepGProp::LinearProperties(shape, linear, true, useTriangulation);
+            BRepGProp::SurfaceProperties(shape, surface, true, useTriangulation);
+            BRepGProp::VolumeProperties(shape, volume, true, true, useTriangulation);
+        }
+
+        const GProp_GProps* dominant = &linear;
+        if (std::abs(volume.Mass()) > Precision::Confusion()) {
+            dominant = &volume;
+        } else if (surface.Mass() > Precision::Confusion()) {
+            dominant = &surface;
+        }
+        return ShapeProperties { linear.Mass(), surface.Mass(), std::abs(volume.Mass()), dominant->CentreOfMass(),
+            dominant->MatrixOfInertia(), error };
+    }
+
+public:
+    /// @brief Length, area, volume, centroid and inertia of every shape in one call, computed in parallel in a
+    /// CHILI_WASM_THREADS build. Mesh mode is much faster and accurate to lineDeflection (relative to the shape
+    /// size, as in Mesher); it is ignored in Exact mode.
+    static MassProperties properties(const ShapeArray& shapes, MassPropertyMode mode, double tolerance,
+        double lineDeflection)
+    {
+        auto shapeVec = vecFromJSArray<TopoDS_Shape>(shapes);
+        // meshed one by one, since shapes of the batch may share faces
+        std::vector<std::unique_ptr<ScopedTriangulation>> triangulations;
+        if (mode == MassPropertyMode::Mesh) {
+            for (const auto& shape : shapeVec) {
+                triangulations.push_back(std::make_unique<ScopedTriangulation>(shape, lineDeflection));
+            }
+        }
+
+        std::vector<ShapeProperties> results(shapeVec.size());
+        OSD_Parallel::For(0, static_cast<int>(shapeVec.size()),
+            [&](int index) { results[index] = shapeProperties(shapeVec[index], mode, tolerance); });
+
+        // restore in reverse, so a face meshed twice ends up with its original triangulation
+        while (!triangulations.empty()) {
+            triangulations.pop_back();
+        }
+
+        std::vector<double> length, area, volume, centroid, inertia, error;
+        for (const auto& result : results) {
+            length.push_back(result.length);
+            area.push_back(result.area);
+            volume.push_back(result.volume);
+            centroid.insert(centroid.end(), { result.centroid.X(), result.centroid.Y(), result.centroid.Z() });
+            const auto& m = result.inertia;
+            inertia.insert(inertia.end(),
+                { m.Value(1, 1), m.Value(2, 2), m.Value(3, 3), m.Value(1, 2), m.Value(1, 3), m.Value(2, 3) });
+            error.push_back(result.error);
+        }
+
+        return MassProperties { toTypedArray<Float64Array>(length), toTypedArray<Float64Array>(area),
+            toTypedArray<Float64Array>(volume), toTypedArray<Float64Array>(centroid),
+            toTypedArray<Float64Array>(inertia), toTypedArray<Float64Array>(error) };
+    }
+
+    /// @brief Packed AABB (and with oriented, OBB) hierarchy of shape -> solids -> faces for culling and LOD
+    static BoundsHierarchy bounds(const TopoDS_Shape& shape, bool oriented)
+    {
+        BoundsBuilder builder(oriented);
+        Bnd_OBB obb;
+        builder.addShape(shape, -1, obb);
+        return builder.result();
+    }
+
+    /// @brief Minimum distances between shapes. With threshold >= 0 only pairs closer than threshold are
+    /// reported (threshold 0 finds touching or interfering pairs); with a negative threshold every pair is.
+    /// Pairs are computed in parallel in a CHILI_WASM_THREADS build.
+    static DistanceResult distances(const ShapeArray& shapes, double threshold)
+    {
+        auto shapeVec = vecFromJSArray<TopoDS_Shape>(shapes);
+        std::vector<Bnd_Box> boxes(shapeVec.size());
+        for (size_t i = 0; i < shapeVec.size(); i++) {
+            BRepBndLib::Add(shapeVec[i], boxes[i], true);
+        }
+
+        auto candidates = broadPhase(boxes, threshold);
+        OSD_Parallel::For(0, static_cast<int>(candidates.size()), [&](int index) {
+            auto& candidate = candidates[index];
+            BRepExtrema_DistShapeShape extrema(shapeVec[candidate.first], shapeVec[candidate.second]);
+            if (extrema.IsDone() && extrema.NbSolution() > 0) {
+                candidate.isDone = true;
+                candidate.distance = extrema.Value();
+                candidate.point1 = extrema.PointOnShape1(1);
+                candidate.point2 = extrema.PointOnShape2(1);
+            }
+        });
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.first != b.first ? a.first < b.first : a.second < b.second;
+        });
+        std::vector<int> pairs;
+        std::vector<double> distanceValues;
+        std::vector<double> points;
+        std::vector<uint8_t> overlaps;
+        for (const auto& candidate : candidates) {
+            if (!candidate.isDone || (threshold >= 0 && candidate.distance > threshold)) {
+                continue;
+            }
+            pairs.insert(pairs.end(), { candidate.first, candidate.second });
+            distanceValues.push_back(candidate.distance);
+            points.insert(points.end(), { candidate.point1.X(), candidate.point1.Y(), candidate.point1.Z(),
+                                            candidate.point2.X(), candidate.point2.Y(), candidate.point2.Z() });
+            overlaps.push_back(candidate.distance <= Precision::Confusion() ? 1 : 0);
+        }
+
+        return DistanceResult { toTypedArray<Int32Array>(pairs), toTypedArray<Float64Array>(distanceValues),
+            toTypedArray<Float64Array>(points), toTypedArray<Uint8Array>(overlaps) };
+    }
+};
+
+EMSCRIPTEN_BINDINGS(Measure)
+{
+    // DistanceResult：批量距离结果，每个形状对占 pairs 中 2 项、distances 中 1 项、points 中 6 项、overlaps 中 1 项
+    value_object<DistanceResult>("DistanceResult")
+        .field("pairs", &DistanceResult::pairs)
+        .field("distances", &DistanceResult::distances)
+        .field("points", &DistanceResult::points)
+        .field("overlaps", &DistanceResult::overlaps);
+
+    // MassPropertyMode：质量属性计算方式，Exact 为精确积分，Mesh 为基于已有三角网格的快速积分
+    enum_<MassPropertyMode>("MassPropertyMode")
+        .value("Exact", MassPropertyMode::Exact)
+        .value("Mesh", MassPropertyMode::Mesh);
+
+    // MassProperties：批量质量属性结果，centroid 每个形状 3 项，inertia 每个形状 6 项，其余每个形状 1 项
+    value_object<MassProperties>("MassProperties")
+        .field("length", &MassProperties::length)
+        .field("area", &MassProperties::area)
+        .field("volume", &MassProperties::volume)
+        .field("centroid", &MassProperties::centroid)
+        .field("inertia", &MassProperties::inertia)
+        .field("error", &MassProperties::error);
+
+    // BoundsKind：包围盒层次中节点的类型（装配分组、形状、实体、面）
+    enum_<BoundsKind>("BoundsKind")
+        .value("Group", BoundsKind::Group)
+        .value("Shape", BoundsKind::Shape)
+        .value("Solid", BoundsKind::Solid)
+        .value("Face", BoundsKind::Face);
+
+    // BoundsHierarchy：按深度优先顺序打包的包围盒层次，每个节点占 stride 个 float
+    value_object<BoundsHierarchy>("BoundsHierarchy")
+        .field("nodes", &BoundsHierarchy::nodes)
+        .field("stride", &BoundsHierarchy::stride);
+
+    // 绑定 Measure 类（测量 / 干涉检查）
+    class_<Measure>("Measure")
+        // distances(shapes, threshold) -> DistanceResult：计算形状两两之间的最小距离。
+        // 先用包围盒扫描线剔除，再用 BRepExtrema_DistShapeShape 精确计算；threshold >= 0 时只返回距离不超过
+        // threshold 的形状对（0 即接触 / 干涉检查），threshold < 0 时返回所有形状对
+        .class_function("distances", &Measure::distances)
+        // properties(shapes, mode, tolerance, lineDeflection) -> MassProperties：批量计算长度、面积、体积、质心和
+        // 惯性矩（相对质心）。Exact 模式下 tolerance > 0 时按相对误差控制积分精度；Mesh 模式按 lineDeflection
+        // 临时三角化后积分，速度更快，计算完成后恢复面原有的三角网格
+        .class_function("properties", &Measure::properties)
+        // bounds(shape, oriented) -> BoundsHierarchy：计算形状、各实体及各面的轴对齐包围盒（oriented 为 true 时
+        // 同时计算有向包围盒），优先使用三角网格快速计算，用于视锥剔除和 LOD
+        .class_function("bounds", &Measure::bounds);
+}
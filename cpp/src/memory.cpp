@@ -0,0 +1,222 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <BRep_CurveRepresentation.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Transient.hxx>
+#include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <malloc.h>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+#include "memory.hpp"
+#include "shared.hpp"
+
+using namespace emscripten;
+
+/// @brief Walks the shapes held by the application and counts the distinct transients they keep alive
+/// (TShapes, curve representations, geometry, meshes) and the triangulation bytes of each shape.
+class ShapeMemoryWalker {
+    std::unordered_set<const Standard_Transient*> visited;
+    std::map<std::string, int> transients;
+
+    void visit(const Handle(Standard_Transient) & transient)
+    {
+        if (!transient.IsNull() && visited.insert(transient.get()).second) {
+            transients[transient->DynamicType()->Name()]++;
+        }
+    }
+
+    static double triangulationBytes(const Handle(Poly_Triangulation) & triangulation)
+    {
+        double nodes = triangulation->NbNodes();
+        double bytes = nodes * 3 * sizeof(double) + triangulation->NbTriangles() * sizeof(Poly_Triangle);
+        if (triangulation->HasUVNodes()) {
+            bytes += nodes * 2 * sizeof(double);
+        }
+        if (triangulation->HasNormals()) {
+            bytes += nodes * 3 * sizeof(float);
+        }
+        return bytes;
+    }
+
+    static double polygonBytes(const Handle(Poly_PolygonOnTriangulation) & polygon)
+    {
+        double nodes = polygon->NbNodes();
+        return nodes * sizeof(int) + (polygon->HasParameters() ? nodes * sizeof(double) : 0);
+    }
+
+    double visitEdge(const TopoDS_Edge& edge, std::unordered_set<const Standard_Transient*>& meshes)
+    {
+        double bytes = 0;
+        Handle(BRep_TEdge) tedge = Handle(BRep_TEdge)::DownCast(edge.TShape());
+        if (tedge.IsNull()) {
+            return bytes;
+        }
+
+        for (const auto& representation : tedge->Curves()) {
+            visit(representation);
+            if (representation->IsCurve3D()) {
+                visit(representation->Curve3D());
+            } else if (representation->IsCurveOnSurface()) {
+                visit(representation->PCurve());
+                if (representation->IsCurveOnClosedSurface()) {
+                    visit(representation->PCurve2());
+                }
+            } else if (representation->IsPolygon3D()) {
+                visit(representation->Polygon3D());
+            } else if (representation->IsPolygonOnTriangulation()) {
+                const auto& polygon = representation->PolygonOnTriangulation();
+                visit(polygon);
+                if (!polygon.IsNull() && meshes.insert(polygon.get()).second) {
+                    bytes += polygonBytes(polygon);
+                }
+            }
+        }
+        return bytes;
+    }
+
+public:
+    /// @brief returns the triangulation bytes (faces and edge polygons) referenced by the shape
+    double visitShape(const TopoDS_Shape& shape)
+    {
+        std::unordered_set<const Standard_Transient*> meshes;
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shape, subShapes);
+        subShapes.Add(shape);
+
+        double bytes = 0;
+        for (int i = 1; i <= subShapes.Extent(); i++) {
+            const auto& subShape = subShapes(i);
+            visit(subShape.TShape());
+            if (subShape.ShapeType() == TopAbs_FACE) {
+                TopLoc_Location location;
+                auto face = TopoDS::Face(subShape);
+                visit(BRep_Tool::Surface(face, location));
+                auto triangulation = BRep_Tool::Triangulation(face, location);
+                visit(triangulation);
+                if (!triangulation.IsNull() && meshes.insert(triangulation.get()).second) {
+                    bytes += triangulationBytes(triangulation);
+                }
+            } else if (subShape.ShapeType() == TopAbs_EDGE) {
+                bytes += visitEdge(TopoDS::Edge(subShape), meshes);
+            }
+        }
+        return bytes;
+    }
+
+    void writeTransients(std::ostream& out) const
+    {
+        out << "{";
+        bool first = true;
+        for (const auto& [name, count] : transients) {
+            out << (first ? "" : ",") << "\"" << name << "\":" << count;
+            first = false;
+        }
+        out << "}";
+    }
+};
+
+class Memory {
+public:
+    /// @brief bytes currently allocated through malloc
+    static double heapInUse()
+    {
+        struct mallinfo info = mallinfo();
+        return info.uordblks;
+    }
+
+    static HeapStatistics heapStatistics()
+    {
+        return MemoryArena::statistics();
+    }
+
+    static void resetPeak()
+    {
+        MemoryArena::resetPeak();
+    }
+
+    static void setArenaMode(bool enabled)
+    {
+        MemoryArena::setEnabled(enabled);
+    }
+
+    static bool isArenaMode()
+    {
+        return MemoryArena::isEnabled();
+    }
+
+    /// @brief JSON report of the heap statistics; with detailed, also the live transients by type reachable
+    /// from shapes (the shapes held by the application) and the triangulation bytes of each of them.
+    /// Without detailed it only reads allocator counters and is cheap enough to sample continuously.
+    static std::string diagnostics(const ShapeArray& shapes, bool detailed)
+    {
+        auto heap = MemoryArena::statistics();
+        std::ostringstream out;
+        out.precision(15);
+        out << "{\"heap\":{\"heapSize\":" << heap.heapSize << ",\"footprint\":" << heap.footprint
+            << ",\"peakFootprint\":" << heap.peakFootprint << ",\"inUse\":" << heap.inUse
+            << ",\"peakInUse\":" << heap.peakInUse << ",\"free\":" << heap.free
+            << ",\"fragmentation\":" << heap.fragmentation << ",\"arenaCalls\":" << heap.arenaCalls << "}";
+
+        auto shapeVec = vecFromJSArray<TopoDS_Shape>(shapes);
+        out << ",\"liveShapes\":" << shapeVec.size();
+        if (detailed) {
+            ShapeMemoryWalker walker;
+            double total = 0;
+            out << ",\"triangulationBytes\":[";
+            for (size_t i = 0; i < shapeVec.size(); i++) {
+                double bytes = walker.visitShape(shapeVec[i]);
+                total += bytes;
+                out << (i == 0 ? "" : ",") << bytes;
+            }
+            out << "],\"totalTriangulationBytes\":" << total << ",\"transients\":";
+            walker.writeTransients(out);
+        }
+        out << "}";
+        return out.str();
+    }
+};
+
+EMSCRIPTEN_BINDINGS(Memory)
+{
+    // HeapStatistics：堆统计（字节），用于比较普通模式与 arena 模式下的内存占用与碎片
+    value_object<HeapStatistics>("HeapStatistics")
+        .field("heapSize", &HeapStatistics::heapSize)
+        .field("footprint", &HeapStatistics::footprint)
+        .field("peakFootprint", &HeapStatistics::peakFootprint)
+        .field("inUse", &HeapStatistics::inUse)
+        .field("peakInUse", &HeapStatistics::peakInUse)
+        .field("free", &HeapStatistics::free)
+        .field("fragmentation", &HeapStatistics::fragmentation)
+        .field("arenaCalls", &HeapStatistics::arenaCalls);
+
+    // 绑定 Memory 类（内存统计）
+    class_<Memory>("Memory")
+        // heapInUse() -> number：当前通过 malloc 分配且未释放的字节数
+        .class_function("heapInUse", &Memory::heapInUse)
+        // heapStatistics() -> HeapStatistics：wasm 内存大小、malloc 占用 / 峰值 / 空闲与碎片率
+        .class_function("heapStatistics", &Memory::heapStatistics)
+        // resetPeak()：重置 peakInUse，便于按操作测量峰值
+        .class_function("resetPeak", &Memory::resetPeak)
+        // setArenaMode(enabled) / isArenaMode()：开启后，布尔运算、圆角、网格化等调用的临时数据
+        // 从单次调用的增量分配器（NCollection_IncAllocator）分配，调用结束时整体释放
+        .class_function("setArenaMode", &Memory::setArenaMode)
+        .class_function("isArenaMode", &Memory::isArenaMode)
+        // diagnostics(shapes, detailed) -> string：JSON 诊断报告。shapes 为应用当前持有的形状；
+        // detailed 为 false 时只读取分配器计数，可每秒采样；为 true 时额外统计按类型分组的存活 Standard_Transient
+        // （TShape、曲线表示、几何、网格）以及每个形状占用的三角化内存
+        .class_function("diagnostics", &Memory::diagnostics);
+}
@@ -0,0 +1,112 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <emscripten/heap.h>
+
+#include <NCollection_BaseAllocator.hxx>
+#include <NCollection_IncAllocator.hxx>
+#include <Standard_Handle.hxx>
+
+#include <algorithm>
+#include <malloc.h>
+
+struct HeapStatistics {
+    /// @brief size of the wasm linear memory
+    double heapSize;
+    /// @brief bytes malloc has taken from the linear memory (in use + free)
+    double footprint;
+    double peakFootprint;
+    double inUse;
+    /// @brief highest in-use value seen by statistics() or at the end of an arena call
+    double peakInUse;
+    double free;
+    /// @brief free bytes below the top chunk divided by the footprint; these cannot be given back to the top
+    double fragmentation;
+    /// @brief number of binding calls that ran with their own arena
+    int arenaCalls;
+};
+
+/// @brief Arena mode: temporaries of a binding call (pave filler data structure, sub-shape maps...) come from
+/// one NCollection_IncAllocator which is released in bulk when the call returns, instead of being spread over
+/// the malloc heap between long-lived shapes.
+class MemoryArena {
+    friend class ArenaScope;
+
+    inline static bool enabled = false;
+    inline static Handle(NCollection_BaseAllocator) current;
+    inline static double peakInUse = 0;
+    inline static int arenaCalls = 0;
+
+public:
+    static void setEnabled(bool isEnabled)
+    {
+        enabled = isEnabled;
+    }
+
+    static bool isEnabled()
+    {
+        return enabled;
+    }
+
+    /// @brief the arena of the running call, or the common allocator outside arena mode
+    static Handle(NCollection_BaseAllocator) allocator()
+    {
+        return current.IsNull() ? NCollection_BaseAllocator::CommonBaseAllocator() : current;
+    }
+
+    static double sampleInUse()
+    {
+        struct mallinfo info = mallinfo();
+        peakInUse = std::max(peakInUse, static_cast<double>(info.uordblks));
+        return info.uordblks;
+    }
+
+    static HeapStatistics statistics()
+    {
+        sampleInUse();
+        struct mallinfo info = mallinfo();
+        double footprint = static_cast<double>(info.uordblks) + info.fordblks;
+        double fragmented = static_cast<double>(info.fordblks) - info.keepcost;
+        return HeapStatistics { static_cast<double>(emscripten_get_heap_size()), footprint,
+            static_cast<double>(info.usmblks), static_cast<double>(info.uordblks), peakInUse,
+            static_cast<double>(info.fordblks), footprint > 0 ? std::max(fragmented, 0.0) / footprint : 0,
+            arenaCalls };
+    }
+
+    static void resetPeak()
+    {
+        peakInUse = 0;
+        sampleInUse();
+    }
+};
+
+/// @brief Opens an arena for the current binding call when arena mode is on. Nested scopes reuse the
+/// outermost arena, which is released when that scope ends.
+class ArenaScope {
+    bool owner;
+
+public:
+    ArenaScope()
+        : owner(MemoryArena::enabled && MemoryArena::current.IsNull())
+    {
+        if (owner) {
+            Handle(NCollection_IncAllocator) arena = new NCollection_IncAllocator();
+            arena->SetThreadSafe(true);
+            MemoryArena::current = arena;
+            MemoryArena::arenaCalls++;
+        }
+    }
+
+    ~ArenaScope()
+    {
+        if (owner) {
+            MemoryArena::sampleInUse();
+            MemoryArena::current.Nullify();
+        }
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+};
@@ -16,23 +16,27 @@
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopLoc_Location.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <UnitsMethods.hxx>
+#include <gp.hxx>
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
 #include <gp_Vec.hxx>
 
+#include "memory.hpp"
+#include "mesher.hpp"
 #include "shared.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+
 using namespace emscripten;
 using namespace std;
 
-const double ANGLE_DEFLECTION = 0.2;
-
 void addPointToPosition(const gp_Pnt& pnt, std::optional<gp_Pnt>& prePnt, std::vector<float>& position)
 {
     if (prePnt.has_value()) {
@@ -127,100 +131,15 @@ public:
     }
 };
 
-class FaceMesher {
-public:
-    std::vector<float> position;
-    std::vector<float> normal;
-    std::vector<float> uv;
-    std::vector<size_t> index;
-    /// @brief start1,count1,start2,count2...
-    std::vector<size_t> group;
-    std::vector<TopoDS_Face> faces;
-
-    void generateFaceMesh(const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly, const gp_Trsf& trsf)
-    {
-        if (handlePoly.IsNull()) {
-            return;
-        }
-
-        bool isMirrod = trsf.VectorialPart().Determinant() < 0;
-        auto orientation = face.Orientation();
-        auto groupStart = this->index.size();
-        auto indexStart = this->position.size() / 3;
-
-        this->fillIndex(indexStart, handlePoly, orientation);
-        this->fillPosition(trsf, handlePoly);
-        this->fillNormal(trsf, face, handlePoly, (orientation == TopAbs_REVERSED) ^ isMirrod);
-        this->fillUv(face, handlePoly);
-
-        this->group.push_back(groupStart);
-        this->group.push_back(this->index.size() - groupStart);
-    }
-
-    void fillPosition(const gp_Trsf& transform, const Handle(Poly_Triangulation) & handlePoly)
-    {
-        for (int index = 0; index < handlePoly->NbNodes(); index++) {
-            auto pnt = handlePoly->Node(index + 1).Transformed(transform);
-            this->position.push_back(pnt.X());
-            this->position.push_back(pnt.Y());
-            this->position.push_back(pnt.Z());
-        }
-    }
-
-    void fillNormal(const gp_Trsf& transform, const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly,
-        bool shouldReverse)
-    {
-        BRepLib_ToolTriangulatedShape::ComputeNormals(face, handlePoly);
-        for (int index = 0; index < handlePoly->NbNodes(); index++) {
-            auto normal = handlePoly->Normal(index + 1);
-            if (shouldReverse) {
-                normal.Reverse();
-            }
-            normal = normal.Transformed(transform);
-            this->normal.push_back(normal.X());
-            this->normal.push_back(normal.Y());
-            this->normal.push_back(normal.Z());
-        }
-    }
-
-    void fillIndex(size_t indexStart, const Handle(Poly_Triangulation) & handlePoly,
-        const TopAbs_Orientation& orientation)
-    {
-        for (int index = 0; index < handlePoly->NbTriangles(); index++) {
-            auto v1(1), v2(2), v3(3);
-            if (orientation == TopAbs_REVERSED) {
-                v2 = 3;
-                v3 = 2;
-            }
-
-            auto triangle = handlePoly->Triangle(index + 1);
-            this->index.push_back(triangle.Value(v1) - 1 + indexStart);
-            this->index.push_back(triangle.Value(v2) - 1 + indexStart);
-            this->index.push_back(triangle.Value(v3) - 1 + indexStart);
-        }
-    }
-
-    void fillUv(const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly)
-    {
-        double aUmin, aUmax, aVmin, aVmax, dUmax, dVmax;
-        BRepTools::UVBounds(face, aUmin, aUmax, aVmin, aVmax);
-        dUmax = (aUmax - aUmin);
-        dVmax = (aVmax - aVmin);
-        for (int index = 0; index < handlePoly->NbNodes(); index++) {
-            auto uv = handlePoly->UVNode(index + 1);
-            this->uv.push_back((uv.X() - aUmin) / dUmax);
-            this->uv.push_back((uv.Y() - aVmin) / dVmax);
-        }
-    }
-};
-
 class Mesher {
     TopoDS_Shape shape;
+    double relativeDeflection;
     double lineDeflection;
 
 public:
     Mesher(const TopoDS_Shape& shape, double lineDeflection)
         : shape(shape)
+        , relativeDeflection(lineDeflection)
     {
         this->lineDeflection = boundingBoxRatio(shape, lineDeflection);
     }
@@ -240,7 +159,9 @@ public:
 
     MeshData mesh()
     {
-        BRepMesh_IncrementalMesh mesh(shape, lineDeflection, true, ANGLE_DEFLECTION, true);
+        ArenaScope arena;
+        // the mesh only lives until the buffers are filled, so shapes sharing these faces never see it
+        ScopedTriangulation triangulation(shape, relativeDeflection);
 
         std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)> facePolyMap;
         auto faceMeshData = meshFaces(facePolyMap);
@@ -252,7 +173,7 @@ public:
     EdgeMeshData meshEdges(std::unordered_map<TopoDS_Face, Handle_Poly_Triangulation>& facePolyMap)
     {
         EdgeMesher mesher(lineDeflection);
-        TopTools_IndexedDataMapOfShapeListOfShape mapEF;
+        TopTools_IndexedDataMapOfShapeListOfShape mapEF(1, MemoryArena::allocator());
         TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, mapEF);
         for (int ie = 1; ie <= mapEF.Extent(); ie++) {
             const TopoDS_Edge& aEdge = TopoDS::Edge(mapEF.FindKey(ie));
@@ -279,28 +200,270 @@ public:
     FaceMeshData meshFaces(std::unordered_map<TopoDS_Face, Handle_Poly_Triangulation>& facePolyMap)
     {
         FaceMesher mesher;
-        TopTools_IndexedMapOfShape faceMap;
-        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
-        for (TopTools_IndexedMapOfShape::Iterator anIt(faceMap); anIt.More(); anIt.Next()) {
-            auto face = TopoDS::Face(anIt.Value());
-            mesher.faces.push_back(face);
-            TopLoc_Location location;
-            auto handlePoly = BRep_Tool::Triangulation(face, location);
-            if (!handlePoly.IsNull()) {
-                auto trsf = location.Transformation();
-                mesher.generateFaceMesh(face, handlePoly, trsf);
-                facePolyMap[face] = handlePoly;
-            }
-        }
+        mesher.generateShapeMesh(shape, facePolyMap);
 
         return FaceMeshData { NumberArray(val::array(mesher.position)), NumberArray(val::array(mesher.normal)),
             NumberArray(val::array(mesher.uv)), NumberArray(val::array(mesher.index)),
             NumberArray(val::array(mesher.group)), FaceArray(val::array(mesher.faces)) };
     }
+};
 
-    ~Mesher()
+/// @brief Extrusion preview built from the profile tessellation only: caps are the profile triangles at the
+/// start and the end of the sweep, side walls are quads swept from the polylines of the edges bounding at most
+/// one profile face. Buffers are sized once in the constructor and rewritten in place by update(), so dragging
+/// the distance never builds BRep.
+class ExtrudePreview {
+    struct ProfileFace {
+        gp_Dir normal;
+        size_t nodeStart;
+        size_t nodeCount;
+        size_t indexStart;
+        size_t indexCount;
+        int side;
+    };
+
+    struct BoundarySegment {
+        gp_Pnt start;
+        gp_Pnt end;
+        /// @brief index in faces, -1 for edges that bound no face (open sketch)
+        int face;
+    };
+
+    std::vector<float> capPosition;
+    std::vector<float> capNormal;
+    std::vector<uint32_t> capIndex;
+    std::vector<ProfileFace> faces;
+    std::vector<BoundarySegment> segments;
+
+    std::vector<float> positionBuffer;
+    std::vector<float> normalBuffer;
+    std::vector<uint32_t> indexBuffer;
+
+    void collectFaces(const TopoDS_Shape& profile, std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)>& facePolyMap)
     {
-        BRepTools::Clean(shape, true);
+        FaceMesher mesher;
+        mesher.generateShapeMesh(profile, facePolyMap);
+        size_t nodeStart = 0;
+        for (size_t i = 0; i < mesher.faces.size(); i++) {
+            auto it = facePolyMap.find(mesher.faces[i]);
+            if (it == facePolyMap.end()) {
+                continue;
+            }
+
+            // generateShapeMesh only emits groups for triangulated faces, in face order
+            size_t group = faces.size();
+            size_t indexStart = mesher.group[group * 2];
+            size_t indexCount = mesher.group[group * 2 + 1];
+            size_t nodeCount = it->second->NbNodes();
+            gp_Vec normal(mesher.normal[nodeStart * 3], mesher.normal[nodeStart * 3 + 1],
+                mesher.normal[nodeStart * 3 + 2]);
+            faces.push_back(ProfileFace { normal.Magnitude() > gp::Resolution() ? gp_Dir(normal) : gp_Dir(0, 0, 1),
+                nodeStart, nodeCount, indexStart, indexCount, 1 });
+            nodeStart += nodeCount;
+        }
+
+        capPosition = std::move(mesher.position);
+        capNormal = std::move(mesher.normal);
+        capIndex.assign(mesher.index.begin(), mesher.index.end());
+    }
+
+    void addPolyline(std::vector<gp_Pnt>& points, bool reversed, int face)
+    {
+        if (reversed) {
+            std::reverse(points.begin(), points.end());
+        }
+        for (size_t i = 1; i < points.size(); i++) {
+            segments.push_back(BoundarySegment { points[i - 1], points[i], face });
+        }
+    }
+
+    void collectBoundary(const TopoDS_Shape& profile, double lineDeflection,
+        const std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)>& facePolyMap)
+    {
+        TopTools_IndexedMapOfShape faceMap;
+        TopExp::MapShapes(profile, TopAbs_FACE, faceMap);
+        TopTools_IndexedDataMapOfShapeListOfShape mapEF;
+        TopExp::MapShapesAndUniqueAncestors(profile, TopAbs_EDGE, TopAbs_FACE, mapEF);
+
+        int faceIndex = 0;
+        for (int i = 1; i <= faceMap.Extent(); i++) {
+            auto face = TopoDS::Face(faceMap(i));
+            auto it = facePolyMap.find(face);
+            if (it == facePolyMap.end()) {
+                continue;
+            }
+
+            // the explorer composes orientations, so boundary edges run with the material on their left
+            for (TopExp_Explorer explorer(face, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+                auto edge = TopoDS::Edge(explorer.Current());
+                // an edge between two profile faces is inside the extruded solid and gets no wall
+                if (mapEF.FindFromKey(edge).Extent() > 1) {
+                    continue;
+                }
+                std::vector<gp_Pnt> points;
+                TopLoc_Location location;
+                auto polygon = BRep_Tool::PolygonOnTriangulation(edge, it->second, location);
+                if (polygon.IsNull()) {
+                    sampleEdge(edge, lineDeflection, points);
+                } else {
+                    auto trsf = location.Transformation();
+                    const auto& nodes = polygon->Nodes();
+                    for (auto j = nodes.Lower(); j <= nodes.Upper(); j++) {
+                        points.push_back(it->second->Node(nodes[j]).Transformed(trsf));
+                    }
+                }
+                addPolyline(points, edge.Orientation() == TopAbs_REVERSED, faceIndex);
+            }
+            faceIndex++;
+        }
+
+        for (int i = 1; i <= mapEF.Extent(); i++) {
+            if (mapEF(i).IsEmpty()) {
+                std::vector<gp_Pnt> points;
+                sampleEdge(TopoDS::Edge(mapEF.FindKey(i)), lineDeflection, points);
+                addPolyline(points, false, -1);
+            }
+        }
+    }
+
+    static void sampleEdge(const TopoDS_Edge& edge, double lineDeflection, std::vector<gp_Pnt>& points)
+    {
+        BRepAdaptor_Curve curve(edge);
+        GCPnts_TangentialDeflection pnts(curve, ANGLE_DEFLECTION, lineDeflection);
+        for (int i = 1; i <= pnts.NbPoints(); i++) {
+            points.push_back(pnts.Value(i));
+        }
+    }
+
+    void writeIndex()
+    {
+        size_t capNodes = capPosition.size() / 3;
+        size_t offset = 0;
+        for (const auto& face : faces) {
+            for (size_t i = face.indexStart; i < face.indexStart + face.indexCount; i += 3) {
+                // the cap facing away from the sweep keeps the profile winding, the other one is flipped
+                uint32_t a = capIndex[i], b = capIndex[i + 1], c = capIndex[i + 2];
+                uint32_t bottom = face.side > 0 ? 0 : capNodes;
+                uint32_t top = face.side > 0 ? capNodes : 0;
+                indexBuffer[offset++] = a + top;
+                indexBuffer[offset++] = b + top;
+                indexBuffer[offset++] = c + top;
+                indexBuffer[offset++] = a + bottom;
+                indexBuffer[offset++] = c + bottom;
+                indexBuffer[offset++] = b + bottom;
+            }
+        }
+
+        uint32_t node = capNodes * 2;
+        for (const auto& segment : segments) {
+            bool flip = segment.face >= 0 && faces[segment.face].side < 0;
+            uint32_t a = node, b = node + 1, c = node + 3, d = node + 2;
+            if (flip) {
+                std::swap(b, d);
+            }
+            indexBuffer[offset++] = a;
+            indexBuffer[offset++] = b;
+            indexBuffer[offset++] = c;
+            indexBuffer[offset++] = a;
+            indexBuffer[offset++] = c;
+            indexBuffer[offset++] = d;
+            node += 4;
+        }
+    }
+
+    static void writeVector(std::vector<float>& buffer, size_t offset, double x, double y, double z)
+    {
+        buffer[offset] = x;
+        buffer[offset + 1] = y;
+        buffer[offset + 2] = z;
+    }
+
+public:
+    ExtrudePreview(const TopoDS_Shape& profile, double lineDeflection)
+    {
+        double deflection = boundingBoxRatio(profile, lineDeflection);
+        ScopedTriangulation triangulation(profile, lineDeflection);
+
+        std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)> facePolyMap;
+        collectFaces(profile, facePolyMap);
+        collectBoundary(profile, deflection, facePolyMap);
+
+        size_t vertexCount = capPosition.size() / 3 * 2 + segments.size() * 4;
+        positionBuffer.resize(vertexCount * 3);
+        normalBuffer.resize(vertexCount * 3);
+        indexBuffer.resize(capIndex.size() * 2 + segments.size() * 6);
+        writeIndex();
+    }
+
+    /// @brief Rewrites position and normal for a new extrusion vector. Returns true when the index buffer was
+    /// rewritten as well, which only happens when the sweep crosses the profile plane.
+    bool update(const Vector3& vector)
+    {
+        gp_Vec direction = Vector3::toVec(vector);
+        bool sideChanged = false;
+        for (auto& face : faces) {
+            int side = direction.Dot(gp_Vec(face.normal)) < 0 ? -1 : 1;
+            sideChanged |= side != face.side;
+            face.side = side;
+        }
+        if (sideChanged) {
+            writeIndex();
+        }
+
+        size_t capOffset = capPosition.size();
+        for (const auto& face : faces) {
+            for (size_t i = face.nodeStart * 3; i < (face.nodeStart + face.nodeCount) * 3; i += 3) {
+                writeVector(positionBuffer, i, capPosition[i], capPosition[i + 1], capPosition[i + 2]);
+                writeVector(positionBuffer, capOffset + i, capPosition[i] + direction.X(),
+                    capPosition[i + 1] + direction.Y(), capPosition[i + 2] + direction.Z());
+                writeVector(normalBuffer, i, -face.side * capNormal[i], -face.side * capNormal[i + 1],
+                    -face.side * capNormal[i + 2]);
+                writeVector(normalBuffer, capOffset + i, face.side * capNormal[i], face.side * capNormal[i + 1],
+                    face.side * capNormal[i + 2]);
+            }
+        }
+
+        size_t offset = capOffset * 2;
+        for (const auto& segment : segments) {
+            gp_Vec normal = gp_Vec(segment.start, segment.end).Crossed(direction);
+            double magnitude = normal.Magnitude();
+            if (magnitude > gp::Resolution()) {
+                int side = segment.face >= 0 ? faces[segment.face].side : 1;
+                normal *= side / magnitude;
+            }
+
+            const gp_Pnt points[] = { segment.start, segment.end, segment.start.Translated(direction),
+                segment.end.Translated(direction) };
+            for (const auto& point : points) {
+                writeVector(positionBuffer, offset, point.X(), point.Y(), point.Z());
+                writeVector(normalBuffer, offset, normal.X(), normal.Y(), normal.Z());
+                offset += 3;
+            }
+        }
+
+        return sideChanged;
+    }
+
+    /// @brief The typed arrays below are views into the wasm heap: they stay valid across update() calls
+    /// (which never allocate) but must be fetched again after any other call that may grow the memory.
+    Float32Array position() const
+    {
+        return Float32Array(val(typed_memory_view(positionBuffer.size(), positionBuffer.data())));
+    }
+
+    Float32Array normal() const
+    {
+        return Float32Array(val(typed_memory_view(normalBuffer.size(), normalBuffer.data())));
+    }
+
+    Uint32Array index() const
+    {
+        return Uint32Array(val(typed_memory_view(indexBuffer.size(), indexBuffer.data())));
+    }
+
+    int segmentCount() const
+    {
+        return segments.size();
     }
 };
 
@@ -318,6 +481,18 @@ EMSCRIPTEN_BINDINGS(Mesher)
         .function("mesh", &Mesher::mesh)
         .function("edgesMeshPosition", &Mesher::edgesMeshPosition);
 
+    // ExtrudePreview 类：拉伸预览。复用轮廓已有的三角化，直接生成两端盖面与侧壁条带，不构建 BRep。
+    // - 构造函数 ExtrudePreview(profile, lineDeflection)：轮廓可以是面、线框或边；一次性分配缓冲区。
+    // - update(vector)：按新的拉伸向量原地改写 position / normal（构造后需先调用一次）；返回 true 表示 index 也被改写（方向跨越轮廓平面）。
+    // - position() / normal() / index()：返回指向 wasm 内存的视图（不拷贝），可直接上传到 GPU 缓冲区。
+    class_<ExtrudePreview>("ExtrudePreview")
+        .constructor<TopoDS_Shape, double>()
+        .function("update", &ExtrudePreview::update)
+        .function("position", &ExtrudePreview::position)
+        .function("normal", &ExtrudePreview::normal)
+        .function("index", &ExtrudePreview::index)
+        .function("segmentCount", &ExtrudePreview::segmentCount);
+
     // EdgeMeshData：边网格化结果的结构封装
     // - position: 以连续 float 数组保存边上的顶点坐标（x,y,z,...），编码为相邻点对以便绘制线段。
     // - group: 按段记录 start,count 对，描述每条边在 position 中的起始索引与长度（用于区分不同边）。
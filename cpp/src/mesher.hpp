@@ -0,0 +1,236 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <BRepLib_ToolTriangulatedShape.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Polygon3D.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Handle.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Shape.hxx>
+#include <gp_Trsf.hxx>
+
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils.hpp"
+
+/// @brief Meshes the shape like Mesher does for the lifetime of the object and then puts back the triangulation
+/// each face and the polygon each free edge had before, dropping the edge polygons that referenced the new face
+/// meshes. Exporters thus leave neither new meshes on the caller's (possibly shared) faces nor replace theirs.
+/// BRepMesh keeps an existing face triangulation only when it is within the requested deflection.
+class ScopedTriangulation {
+private:
+    std::vector<std::pair<TopoDS_Face, Handle(Poly_Triangulation)>> faces;
+    std::vector<std::pair<TopoDS_Edge, Handle(Poly_Polygon3D)>> edges;
+
+public:
+    ScopedTriangulation(const TopoDS_Shape& shape, double lineDeflection)
+    {
+        TopTools_IndexedMapOfShape faceMap, edgeMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+        faces.reserve(faceMap.Extent());
+        for (int i = 1; i <= faceMap.Extent(); i++) {
+            TopLoc_Location location;
+            auto face = TopoDS::Face(faceMap(i));
+            faces.emplace_back(face, BRep_Tool::Triangulation(face, location));
+        }
+        edges.reserve(edgeMap.Extent());
+        for (int i = 1; i <= edgeMap.Extent(); i++) {
+            TopLoc_Location location;
+            auto edge = TopoDS::Edge(edgeMap(i));
+            edges.emplace_back(edge, BRep_Tool::Polygon3D(edge, location));
+        }
+        BRepMesh_IncrementalMesh mesh(shape, boundingBoxRatio(shape, lineDeflection), true, ANGLE_DEFLECTION, true);
+    }
+
+    ScopedTriangulation(const ScopedTriangulation&) = delete;
+    ScopedTriangulation& operator=(const ScopedTriangulation&) = delete;
+
+    ~ScopedTriangulation()
+    {
+        BRep_Builder builder;
+        for (const auto& [face, previous] : faces) {
+            TopLoc_Location location;
+            auto current = BRep_Tool::Triangulation(face, location);
+            if (current == previous) {
+                continue;
+            }
+            if (!current.IsNull()) {
+                // same clean up as BRepTools::Clean: the edge polygons would keep the new mesh alive
+                for (TopExp_Explorer explorer(face, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+                    builder.UpdateEdge(TopoDS::Edge(explorer.Current()), Handle(Poly_PolygonOnTriangulation)(),
+                        current, location);
+                }
+            }
+            builder.UpdateFace(face, previous);
+        }
+        for (const auto& [edge, previous] : edges) {
+            TopLoc_Location location;
+            if (BRep_Tool::Polygon3D(edge, location) != previous) {
+                builder.UpdateEdge(edge, previous);
+            }
+        }
+    }
+};
+
+/// @brief triangulation of one face, nodes in global coordinates and triangles wound along the face normal
+struct FaceTriangles {
+    TopoDS_Face face;
+    std::vector<gp_Pnt> nodes;
+    /// @brief 0-based node indices
+    std::vector<std::array<int, 3>> triangles;
+};
+
+inline std::vector<FaceTriangles> collectFaceTriangles(const TopoDS_Shape& shape)
+{
+    std::vector<FaceTriangles> faces;
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        auto face = TopoDS::Face(faceMap(i));
+        TopLoc_Location location;
+        auto triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) {
+            continue;
+        }
+
+        FaceTriangles item { face, {}, {} };
+        auto trsf = location.Transformation();
+        item.nodes.reserve(triangulation->NbNodes());
+        for (int n = 1; n <= triangulation->NbNodes(); n++) {
+            item.nodes.push_back(triangulation->Node(n).Transformed(trsf));
+        }
+
+        bool reversed = (face.Orientation() == TopAbs_REVERSED) ^ (trsf.VectorialPart().Determinant() < 0);
+        item.triangles.reserve(triangulation->NbTriangles());
+        for (int t = 1; t <= triangulation->NbTriangles(); t++) {
+            int n1, n2, n3;
+            triangulation->Triangle(t).Get(n1, n2, n3);
+            item.triangles.push_back(reversed ? std::array<int, 3> { n1 - 1, n3 - 1, n2 - 1 }
+                                              : std::array<int, 3> { n1 - 1, n2 - 1, n3 - 1 });
+        }
+        faces.push_back(std::move(item));
+    }
+    return faces;
+}
+
+class FaceMesher {
+public:
+    std::vector<float> position;
+    std::vector<float> normal;
+    std::vector<float> uv;
+    std::vector<size_t> index;
+    /// @brief start1,count1,start2,count2...
+    std::vector<size_t> group;
+    std::vector<TopoDS_Face> faces;
+
+    void generateShapeMesh(const TopoDS_Shape& shape,
+        std::unordered_map<TopoDS_Face, Handle(Poly_Triangulation)>& facePolyMap)
+    {
+        TopTools_IndexedMapOfShape faceMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        for (TopTools_IndexedMapOfShape::Iterator anIt(faceMap); anIt.More(); anIt.Next()) {
+            auto face = TopoDS::Face(anIt.Value());
+            this->faces.push_back(face);
+            TopLoc_Location location;
+            auto handlePoly = BRep_Tool::Triangulation(face, location);
+            if (!handlePoly.IsNull()) {
+                auto trsf = location.Transformation();
+                this->generateFaceMesh(face, handlePoly, trsf);
+                facePolyMap[face] = handlePoly;
+            }
+        }
+    }
+
+    void generateFaceMesh(const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly, const gp_Trsf& trsf)
+    {
+        if (handlePoly.IsNull()) {
+            return;
+        }
+
+        bool isMirrod = trsf.VectorialPart().Determinant() < 0;
+        auto orientation = face.Orientation();
+        auto groupStart = this->index.size();
+        auto indexStart = this->position.size() / 3;
+
+        this->fillIndex(indexStart, handlePoly, orientation);
+        this->fillPosition(trsf, handlePoly);
+        this->fillNormal(trsf, face, handlePoly, (orientation == TopAbs_REVERSED) ^ isMirrod);
+        this->fillUv(face, handlePoly);
+
+        this->group.push_back(groupStart);
+        this->group.push_back(this->index.size() - groupStart);
+    }
+
+    void fillPosition(const gp_Trsf& transform, const Handle(Poly_Triangulation) & handlePoly)
+    {
+        for (int index = 0; index < handlePoly->NbNodes(); index++) {
+            auto pnt = handlePoly->Node(index + 1).Transformed(transform);
+            this->position.push_back(pnt.X());
+            this->position.push_back(pnt.Y());
+            this->position.push_back(pnt.Z());
+        }
+    }
+
+    void fillNormal(const gp_Trsf& transform, const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly,
+        bool shouldReverse)
+    {
+        BRepLib_ToolTriangulatedShape::ComputeNormals(face, handlePoly);
+        for (int index = 0; index < handlePoly->NbNodes(); index++) {
+            auto normal = handlePoly->Normal(index + 1);
+            if (shouldReverse) {
+                normal.Reverse();
+            }
+            normal = normal.Transformed(transform);
+            this->normal.push_back(normal.X());
+            this->normal.push_back(normal.Y());
+            this->normal.push_back(normal.Z());
+        }
+    }
+
+    void fillIndex(size_t indexStart, const Handle(Poly_Triangulation) & handlePoly,
+        const TopAbs_Orientation& orientation)
+    {
+        for (int index = 0; index < handlePoly->NbTriangles(); index++) {
+            auto v1(1), v2(2), v3(3);
+            if (orientation == TopAbs_REVERSED) {
+                v2 = 3;
+                v3 = 2;
+            }
+
+            auto triangle = handlePoly->Triangle(index + 1);
+            this->index.push_back(triangle.Value(v1) - 1 + indexStart);
+            this->index.push_back(triangle.Value(v2) - 1 + indexStart);
+            this->index.push_back(triangle.Value(v3) - 1 + indexStart);
+        }
+    }
+
+    void fillUv(const TopoDS_Face& face, const Handle(Poly_Triangulation) & handlePoly)
+    {
+        double aUmin, aUmax, aVmin, aVmax, dUmax, dVmax;
+        BRepTools::UVBounds(face, aUmin, aUmax, aVmin, aVmax);
+        dUmax = (aUmax - aUmin);
+        dVmax = (aVmax - aVmin);
+        for (int index = 0; index < handlePoly->NbNodes(); index++) {
+            auto uv = handlePoly->UVNode(index + 1);
+            this->uv.push_back((uv.X() - aUmin) / dUmax);
+            this->uv.push_back((uv.Y() - aVmin) / dVmax);
+        }
+    }
+};
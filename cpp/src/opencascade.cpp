@@ -3,6 +3,7 @@
 
 #include <emscripten/bind.h>
 
+#include <BOPAlgo_GlueEnum.hxx>
 #include <BRep_Tool.hxx>
 #include <GeomAbs_JoinType.hxx>
 #include <GeomAbs_Shape.hxx>
@@ -74,6 +75,12 @@ EMSCRIPTEN_BINDINGS(opencascade)
         .value("GeomAbs_Intersection", GeomAbs_Intersection)
         .value("GeomAbs_Tangent", GeomAbs_Tangent);
 
+    // BOPAlgo_GlueEnum：布尔运算粘合模式（关闭/平移/完全）
+    enum_<BOPAlgo_GlueEnum>("BOPAlgo_GlueEnum")
+        .value("BOPAlgo_GlueOff", BOPAlgo_GlueOff)
+        .value("BOPAlgo_GlueShift", BOPAlgo_GlueShift)
+        .value("BOPAlgo_GlueFull", BOPAlgo_GlueFull);
+
     // TopAbs_ShapeEnum：TopoDS 中形状类型枚举（VERTEX/EDGE/.../SHAPE）
     enum_<TopAbs_ShapeEnum>("TopAbs_ShapeEnum")
         .value("TopAbs_VERTEX", TopAbs_VERTEX)
@@ -8,6 +8,7 @@
 #include <BRepAlgoAPI_Defeaturing.hxx>
 #include <BRepAlgoAPI_Section.hxx>
 #include <BRepAlgoAPI_Splitter.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
@@ -22,6 +23,7 @@
 #include <BRepTools_WireExplorer.hxx>
 #include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
 #include <GCPnts_AbscissaPoint.hxx>
 #include <GProp_GProps.hxx>
 #include <GeomAbs_JoinType.hxx>
@@ -30,6 +32,10 @@
 #include <HLRAlgo_Projector.hxx>
 #include <HLRBRep_Algo.hxx>
 #include <HLRBRep_HLRToShape.hxx>
+#include <HLRBRep_PolyAlgo.hxx>
+#include <HLRBRep_PolyHLRToShape.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
 #include <ShapeAnalysis.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <TopExp.hxx>
@@ -50,11 +56,285 @@
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
 
+#include "memory.hpp"
+#include "mesher.hpp"
 #include "shared.hpp"
+#include "topology.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
 using namespace emscripten;
 
+struct SliceResult {
+    /// @brief x, y, z of every polyline point; polylines of the first plane come first
+    Float64Array points;
+    /// @brief polylines + 1 entries, polyline i owns points polylineOffsets[i] .. polylineOffsets[i + 1] - 1
+    Int32Array polylineOffsets;
+    /// @brief planes + 1 entries, plane j owns polylines planeOffsets[j] .. planeOffsets[j + 1] - 1
+    Int32Array planeOffsets;
+    /// @brief 1 for closed polylines, whose last point repeats the first one
+    Uint8Array closed;
+};
+
+/// @brief edge categories of a polygonal HLR view, in the order of HlrResult.offsets
+enum HlrCategory {
+    HLR_VISIBLE_SHARP,
+    HLR_HIDDEN_SHARP,
+    HLR_VISIBLE_OUTLINE,
+    HLR_HIDDEN_OUTLINE,
+    HLR_VISIBLE_SMOOTH,
+    HLR_HIDDEN_SMOOTH,
+    HLR_CATEGORY_COUNT,
+};
+
+struct HlrResult {
+    /// @brief x1, y1, x2, y2 of every segment, in the view plane coordinates of its view
+    Float32Array segments;
+    /// @brief views * HLR_CATEGORY_COUNT + 1 entries; category c of view v owns segments
+    /// offsets[v * HLR_CATEGORY_COUNT + c] .. offsets[v * HLR_CATEGORY_COUNT + c + 1] - 1
+    Int32Array offsets;
+};
+
+/// @brief Slices the triangulation of a shape with parallel planes. Faces are sorted once by their interval
+/// along the plane normal, so each plane only visits faces whose interval contains it; crossing points are
+/// computed per mesh edge in a canonical direction so that neighbouring triangles produce identical points, and
+/// segment ends closer than the tolerance are welded before they are chained.
+class ShapeSlicer {
+public:
+    struct Polyline {
+        std::vector<gp_Pnt> points;
+        bool closed;
+    };
+
+private:
+    struct SliceFace {
+        size_t mesh;
+        std::vector<double> heights;
+        double min;
+        double max;
+    };
+
+    struct PointKey {
+        int64_t x, y, z;
+
+        bool operator==(const PointKey& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct PointKeyHash {
+        size_t operator()(const PointKey& key) const
+        {
+            size_t hash = std::hash<int64_t> {}(key.x);
+            hash = hash * 31 + std::hash<int64_t> {}(key.y);
+            return hash * 31 + std::hash<int64_t> {}(key.z);
+        }
+    };
+
+    struct Segment {
+        gp_Pnt start;
+        gp_Pnt end;
+        int startVertex = -1;
+        int endVertex = -1;
+    };
+
+    /// @brief welds the segment ends that lie within tolerance, looking into the neighbouring grid cells as well
+    /// so that two copies of a point on either side of a cell border still meet
+    class VertexWelder {
+        double tolerance;
+        std::unordered_map<PointKey, std::vector<int>, PointKeyHash> grid;
+        std::vector<gp_Pnt> points;
+
+    public:
+        VertexWelder(double tolerance)
+            : tolerance(tolerance)
+        {
+        }
+
+        int findOrAdd(const gp_Pnt& point)
+        {
+            double cell = tolerance * 2;
+            PointKey key { std::llround(point.X() / cell), std::llround(point.Y() / cell),
+                std::llround(point.Z() / cell) };
+            for (int64_t i = key.x - 1; i <= key.x + 1; i++) {
+                for (int64_t j = key.y - 1; j <= key.y + 1; j++) {
+                    for (int64_t k = key.z - 1; k <= key.z + 1; k++) {
+                        auto it = grid.find(PointKey { i, j, k });
+                        if (it == grid.end()) {
+                            continue;
+                        }
+                        for (int index : it->second) {
+                            if (points[index].Distance(point) <= tolerance) {
+                                return index;
+                            }
+                        }
+                    }
+                }
+            }
+
+            points.push_back(point);
+            grid[key].push_back(static_cast<int>(points.size()) - 1);
+            return static_cast<int>(points.size()) - 1;
+        }
+
+        size_t size() const
+        {
+            return points.size();
+        }
+    };
+
+    std::vector<FaceTriangles> meshes;
+    std::vector<SliceFace> faces;
+    std::vector<double> faceMins;
+    double tolerance;
+
+    static bool isLess(const gp_Pnt& a, const gp_Pnt& b)
+    {
+        if (a.X() != b.X()) {
+            return a.X() < b.X();
+        }
+        if (a.Y() != b.Y()) {
+            return a.Y() < b.Y();
+        }
+        return a.Z() < b.Z();
+    }
+
+    static gp_Pnt crossing(gp_Pnt a, gp_Pnt b, double ha, double hb)
+    {
+        if (isLess(b, a)) {
+            std::swap(a, b);
+            std::swap(ha, hb);
+        }
+        double t = ha / (ha - hb);
+        return gp_Pnt(a.XYZ() + (b.XYZ() - a.XYZ()) * t);
+    }
+
+    void sliceFace(const SliceFace& face, double offset, std::vector<Segment>& segments) const
+    {
+        const auto& mesh = meshes[face.mesh];
+        for (const auto& triangle : mesh.triangles) {
+            gp_Pnt points[2];
+            int count = 0;
+            for (int i = 0; i < 3 && count < 2; i++) {
+                int a = triangle[i], b = triangle[(i + 1) % 3];
+                double ha = face.heights[a] - offset, hb = face.heights[b] - offset;
+                // a node exactly on the plane counts as below it, which avoids zero-length segments
+                if ((ha > 0) != (hb > 0)) {
+                    points[count++] = crossing(mesh.nodes[a], mesh.nodes[b], ha, hb);
+                }
+            }
+            if (count == 2) {
+                segments.push_back(Segment { points[0], points[1] });
+            }
+        }
+    }
+
+    std::vector<Polyline> chain(std::vector<Segment>& segments) const
+    {
+        VertexWelder welder(tolerance);
+        std::vector<Segment> welded;
+        for (auto& segment : segments) {
+            segment.startVertex = welder.findOrAdd(segment.start);
+            segment.endVertex = welder.findOrAdd(segment.end);
+            if (segment.startVertex != segment.endVertex) {
+                welded.push_back(segment);
+            }
+        }
+
+        std::vector<std::vector<int>> incident(welder.size());
+        for (size_t i = 0; i < welded.size(); i++) {
+            incident[welded[i].startVertex].push_back(i);
+            incident[welded[i].endVertex].push_back(i);
+        }
+
+        std::vector<bool> used(welded.size(), false);
+        auto walk = [&](int first, bool fromStart) {
+            Polyline polyline { {}, false };
+            int startVertex = fromStart ? welded[first].startVertex : welded[first].endVertex;
+            polyline.points.push_back(fromStart ? welded[first].start : welded[first].end);
+            int vertex = startVertex;
+            int current = first;
+            while (current >= 0) {
+                used[current] = true;
+                const auto& segment = welded[current];
+                bool forward = segment.startVertex == vertex;
+                vertex = forward ? segment.endVertex : segment.startVertex;
+                polyline.points.push_back(forward ? segment.end : segment.start);
+
+                current = -1;
+                for (int next : incident[vertex]) {
+                    if (!used[next]) {
+                        current = next;
+                        break;
+                    }
+                }
+            }
+            polyline.closed = polyline.points.size() > 2 && vertex == startVertex;
+            return polyline;
+        };
+
+        std::vector<Polyline> polylines;
+        // open chains start at points with a single incident segment
+        for (size_t vertex = 0; vertex < incident.size(); vertex++) {
+            const auto& ids = incident[vertex];
+            if (ids.size() == 1 && !used[ids[0]]) {
+                polylines.push_back(walk(ids[0], welded[ids[0]].startVertex == static_cast<int>(vertex)));
+            }
+        }
+        for (size_t i = 0; i < welded.size(); i++) {
+            if (!used[i]) {
+                polylines.push_back(walk(i, true));
+            }
+        }
+        return polylines;
+    }
+
+public:
+    ShapeSlicer(const TopoDS_Shape& shape, const gp_Dir& normal, double lineDeflection)
+    {
+        ScopedTriangulation triangulation(shape, lineDeflection);
+        meshes = collectFaceTriangles(shape);
+
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box, false);
+        tolerance = box.IsVoid() ? Precision::Confusion() : std::sqrt(box.SquareExtent()) * 1e-9;
+
+        for (size_t i = 0; i < meshes.size(); i++) {
+            SliceFace face { i, {}, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
+            face.heights.reserve(meshes[i].nodes.size());
+            for (const auto& node : meshes[i].nodes) {
+                double height = normal.XYZ().Dot(node.XYZ());
+                face.heights.push_back(height);
+                face.min = std::min(face.min, height);
+                face.max = std::max(face.max, height);
+            }
+            faces.push_back(std::move(face));
+        }
+        std::sort(faces.begin(), faces.end(), [](const SliceFace& a, const SliceFace& b) { return a.min < b.min; });
+        for (const auto& face : faces) {
+            faceMins.push_back(face.min);
+        }
+    }
+
+    /// @brief polylines of the plane at signed distance offset from the origin along the normal
+    std::vector<Polyline> slice(double offset) const
+    {
+        std::vector<Segment> segments;
+        auto end = std::upper_bound(faceMins.begin(), faceMins.end(), offset) - faceMins.begin();
+        for (long i = 0; i < end; i++) {
+            if (faces[i].max >= offset) {
+                sliceFace(faces[i], offset, segments);
+            }
+        }
+        return chain(segments);
+    }
+};
+
 class Shape {
 public:
     static TopoDS_Shape clone(const TopoDS_Shape& shape)
@@ -63,6 +343,14 @@ public:
         return copy.Shape();
     }
 
+    /// @brief Copy-on-write clone: the result references the same TShape, so geometry and topology are shared
+    /// until an edit (replaceSubShape / removeSubShape) rebuilds the touched part. Meshing and the default
+    /// booleans leave the shared TShapes untouched; booleans with options.nonDestructive = false do not.
+    static TopoDS_Shape cloneShared(const TopoDS_Shape& shape)
+    {
+        return shape;
+    }
+
     static bool isClosed(const TopoDS_Shape& shape)
     {
         return BRep_Tool::IsClosed(shape);
@@ -71,7 +359,8 @@ public:
     static ShapeArray findAncestor(const TopoDS_Shape& from, const TopoDS_Shape& subShape,
         const TopAbs_ShapeEnum& ancestorType)
     {
-        TopTools_IndexedDataMapOfShapeListOfShape map;
+        ArenaScope arena;
+        TopTools_IndexedDataMapOfShapeListOfShape map(1, MemoryArena::allocator());
         TopExp::MapShapesAndAncestors(from, subShape.ShapeType(), ancestorType, map);
         auto index = map.FindIndex(subShape);
         auto shapes = map.FindFromIndex(index);
@@ -87,6 +376,17 @@ public:
         return ShapeArray(val::array(indexShape.cbegin(), indexShape.cend()));
     }
 
+    static ShapeArray findAncestorIndexed(TopologyIndex& index, const TopoDS_Shape& subShape,
+        const TopAbs_ShapeEnum& ancestorType)
+    {
+        return index.ancestors(subShape, ancestorType);
+    }
+
+    static ShapeArray findSubShapesIndexed(const TopologyIndex& index, const TopAbs_ShapeEnum& shapeType)
+    {
+        return index.subShapes(shapeType);
+    }
+
     static ShapeArray iterShape(const TopoDS_Shape& shape)
     {
         val new_array = val::array();
@@ -109,6 +409,34 @@ public:
         return section.Shape();
     }
 
+    /// @brief planes are normal . p = offset; computed in parallel in a CHILI_WASM_THREADS build
+    static SliceResult slice(const TopoDS_Shape& shape, const Vector3& normal, const NumberArray& offsets,
+        double lineDeflection)
+    {
+        auto offsetVec = vecFromJSArray<double>(offsets);
+        ShapeSlicer slicer(shape, Vector3::toDir(normal), lineDeflection);
+        std::vector<std::vector<ShapeSlicer::Polyline>> planes(offsetVec.size());
+        OSD_Parallel::For(0, static_cast<int>(offsetVec.size()), [&](int i) { planes[i] = slicer.slice(offsetVec[i]); });
+
+        std::vector<double> points;
+        std::vector<int> polylineOffsets { 0 };
+        std::vector<int> planeOffsets { 0 };
+        std::vector<uint8_t> closed;
+        for (const auto& polylines : planes) {
+            for (const auto& polyline : polylines) {
+                for (const auto& point : polyline.points) {
+                    points.insert(points.end(), { point.X(), point.Y(), point.Z() });
+                }
+                polylineOffsets.push_back(points.size() / 3);
+                closed.push_back(polyline.closed ? 1 : 0);
+            }
+            planeOffsets.push_back(closed.size());
+        }
+
+        return SliceResult { toTypedArray<Float64Array>(points), toTypedArray<Int32Array>(polylineOffsets),
+            toTypedArray<Int32Array>(planeOffsets), toTypedArray<Uint8Array>(closed) };
+    }
+
     static TopoDS_Shape splitShapes(const ShapeArray& arguments, const ShapeArray& tools)
     {
         TopTools_ListOfShape argumentsList = shapeArrayToListOfShape(arguments);
@@ -173,12 +501,29 @@ public:
         return size == 1;
     }
 
+    /// @brief ShapeFix updates tolerances, pcurves and flags of the edges and vertices around an edit in place,
+    /// which would leak into shapes sharing them (cloneShared, patterns). Replacing the vertices of the edited
+    /// sub-shape with copies makes the ReShape rebuild every edge, wire and face through them, so ShapeFix only
+    /// touches fresh TShapes there; sub-shapes away from the edit keep their identity.
+    static void detachAround(BRepTools_ReShape& reShape, const TopoDS_Shape& edited)
+    {
+        TopTools_IndexedMapOfShape vertices;
+        TopExp::MapShapes(edited, TopAbs_VERTEX, vertices);
+        for (int i = 1; i <= vertices.Extent(); i++) {
+            TopoDS_Shape vertex = vertices(i).Oriented(TopAbs_FORWARD);
+            if (!reShape.IsRecorded(vertex)) {
+                reShape.Replace(vertex, vertex.EmptyCopied());
+            }
+        }
+    }
+
     static TopoDS_Shape removeSubShape(TopoDS_Shape& shape, const ShapeArray& subShapes)
     {
         std::vector<TopoDS_Shape> subShapesVector = vecFromJSArray<TopoDS_Shape>(subShapes);
 
+        ArenaScope arena;
         auto source = hasOnlyOneSub(shape, TopAbs_FACE) ? shapeWires(shape) : shape;
-        TopTools_IndexedDataMapOfShapeListOfShape mapEF;
+        TopTools_IndexedDataMapOfShapeListOfShape mapEF(1, MemoryArena::allocator());
         TopExp::MapShapesAndAncestors(source, TopAbs_EDGE, TopAbs_FACE, mapEF);
         BRepTools_ReShape reShape;
         for (auto& subShape : subShapesVector) {
@@ -188,8 +533,10 @@ public:
             if (mapEF.FindFromKey(subShape, faces)) {
                 for (auto& face : faces) {
                     reShape.Remove(face);
+                    detachAround(reShape, face);
                 }
             }
+            detachAround(reShape, subShape);
         }
 
         ShapeFix_Shape fixer(reShape.Apply(source));
@@ -203,6 +550,7 @@ public:
     {
         BRepTools_ReShape reShape;
         reShape.Replace(subShape, newShape);
+        detachAround(reShape, subShape);
 
         ShapeFix_Shape fixer(reShape.Apply(shape));
         fixer.Perform();
@@ -235,6 +583,57 @@ public:
         HLRBRep_HLRToShape hlrToShape(algo);
         return hlrToShape.VCompound();
     }
+
+    /// @brief Polygonal HLR on the shape triangulation (meshed first if needed). views holds 9 numbers per view:
+    /// location, direction and xDirection of the view plane. Meshing and loading are shared by all views, but
+    /// each view reruns the whole polygonal hiding (HLRBRep_PolyAlgo::Update); that is still much cheaper than
+    /// the exact hlr().
+    static HlrResult hlrPoly(const TopoDS_Shape& shape, const NumberArray& views, double lineDeflection)
+    {
+        ScopedTriangulation triangulation(shape, lineDeflection);
+        Handle(HLRBRep_PolyAlgo) algo = new HLRBRep_PolyAlgo();
+        algo->Load(shape);
+
+        auto values = vecFromJSArray<double>(views);
+        std::vector<float> segments;
+        std::vector<int> offsets { 0 };
+        for (size_t i = 0; i + 9 <= values.size(); i += 9) {
+            gp_Ax3 ax3(gp_Pnt(values[i], values[i + 1], values[i + 2]),
+                gp_Dir(values[i + 3], values[i + 4], values[i + 5]), gp_Dir(values[i + 6], values[i + 7], values[i + 8]));
+            gp_Trsf trsf;
+            trsf.SetTransformation(ax3);
+            algo->Projector(HLRAlgo_Projector(trsf, false, false));
+            algo->Update();
+
+            HLRBRep_PolyHLRToShape hlrToShape;
+            hlrToShape.Update(algo);
+            const TopoDS_Shape categories[HLR_CATEGORY_COUNT] = { hlrToShape.VCompound(), hlrToShape.HCompound(),
+                hlrToShape.OutLineVCompound(), hlrToShape.OutLineHCompound(), hlrToShape.Rg1LineVCompound(),
+                hlrToShape.Rg1LineHCompound() };
+            for (const auto& compound : categories) {
+                appendSegments(compound, segments);
+                offsets.push_back(segments.size() / 4);
+            }
+        }
+
+        return HlrResult { toTypedArray<Float32Array>(segments), toTypedArray<Int32Array>(offsets) };
+    }
+
+    /// @brief the poly HLR result edges are straight segments between their two vertices
+    static void appendSegments(const TopoDS_Shape& compound, std::vector<float>& segments)
+    {
+        for (TopExp_Explorer explorer(compound, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+            TopoDS_Vertex first, last;
+            TopExp::Vertices(TopoDS::Edge(explorer.Current()), first, last);
+            if (first.IsNull() || last.IsNull()) {
+                continue;
+            }
+            auto start = BRep_Tool::Pnt(first);
+            auto end = BRep_Tool::Pnt(last);
+            segments.insert(segments.end(), { static_cast<float>(start.X()), static_cast<float>(start.Y()),
+                                                static_cast<float>(end.X()), static_cast<float>(end.Y()) });
+        }
+    }
 };
 
 class Vertex {
@@ -409,16 +808,24 @@ EMSCRIPTEN_BINDINGS(Shape)
     class_<Shape>("Shape")
         // clone(shape) -> TopoDS_Shape：复制/克隆给定拓扑形状并返回新 Shape
         .class_function("clone", &Shape::clone)
+        // cloneShared(shape) -> TopoDS_Shape：写时复制克隆，共享几何、拓扑与网格，后续编辑时才复制受影响部分
+        .class_function("cloneShared", &Shape::cloneShared)
         // findAncestor(from, subShape, ancestorType) -> ShapeArray：在 from 中查找 subShape 的指定类型祖先
         .class_function("findAncestor", &Shape::findAncestor)
         // findSubShapes(shape, shapeType) -> ShapeArray：在 shape 中查找指定类型的所有子形状并返回数组
         .class_function("findSubShapes", &Shape::findSubShapes)
+        // findAncestorIndexed / findSubShapesIndexed：同上，但使用预先构建的 TopologyIndex，避免每次重建映射
+        .class_function("findAncestorIndexed", &Shape::findAncestorIndexed)
+        .class_function("findSubShapesIndexed", &Shape::findSubShapesIndexed)
         // iterShape(shape) -> ShapeArray：遍历 shape 的直接子节点并返回 JS 数组
         .class_function("iterShape", &Shape::iterShape)
         // sectionSS(shape, otherShape) -> TopoDS_Shape：计算两个 shape 的截交线（shape-shape 切割/截面）
         .class_function("sectionSS", &Shape::sectionSS)
         // sectionSP(shape, pln) -> TopoDS_Shape：计算 shape 与平面 pln 的截交线
         .class_function("sectionSP", &Shape::sectionSP)
+        // slice(shape, normal, offsets, lineDeflection) -> SliceResult：用一组平行平面切割形状的三角网格，
+        // 一次返回所有平面的折线（points + polylineOffsets + planeOffsets + closed），有线程时并行计算
+        .class_function("slice", &Shape::slice)
         // isClosed(shape) -> bool：判断给定拓扑是否为封闭（封闭边/线等）
         .class_function("isClosed", &Shape::isClosed)
         // splitShapes(arguments, tools) -> TopoDS_Shape：用 tools 拆分 arguments 并返回结果形状
@@ -431,6 +838,9 @@ EMSCRIPTEN_BINDINGS(Shape)
         .class_function("replaceSubShape", &Shape::replaceSubShape)
         // hlr(shape, point, direction, xDirection) -> TopoDS_Shape：对 shape 生成 HLR（隐藏线）结果的复合体
         .class_function("hlr", &Shape::hlr)
+        // hlrPoly(shape, views, lineDeflection) -> HlrResult：基于三角网格的多边形 HLR，views 每 9 个数描述一个视图
+        // （位置、方向、x 方向），一次返回所有视图的可见 / 隐藏的尖锐边、轮廓线与光滑边线段
+        .class_function("hlrPoly", &Shape::hlrPoly)
         // sewing(shape1, shape2) -> TopoDS_Shape：缝合两个形状并返回缝合后的形状
         .class_function("sewing", &Shape::sewing);
 
@@ -482,4 +892,50 @@ EMSCRIPTEN_BINDINGS(Shape)
     class_<Solid>("Solid")
         // volume(solid) -> double：计算实体的体积（使用 BRepGProp 的体积属性）
         .class_function("volume", &Solid::volume);
+
+    // HlrCategory：HlrResult.offsets 中每个视图内的边类别顺序
+    enum_<HlrCategory>("HlrCategory")
+        .value("VisibleSharp", HLR_VISIBLE_SHARP)
+        .value("HiddenSharp", HLR_HIDDEN_SHARP)
+        .value("VisibleOutline", HLR_VISIBLE_OUTLINE)
+        .value("HiddenOutline", HLR_HIDDEN_OUTLINE)
+        .value("VisibleSmooth", HLR_VISIBLE_SMOOTH)
+        .value("HiddenSmooth", HLR_HIDDEN_SMOOTH)
+        .value("Count", HLR_CATEGORY_COUNT);
+
+    // HlrResult：多边形 HLR 结果，segments 为视图平面内的线段（x1,y1,x2,y2），offsets 按视图与边类别划分
+    value_object<HlrResult>("HlrResult")
+        .field("segments", &HlrResult::segments)
+        .field("offsets", &HlrResult::offsets);
+
+    // SliceResult：多平面切片结果，所有折线的点连续存放于 points（x,y,z），按 polylineOffsets / planeOffsets 划分
+    value_object<SliceResult>("SliceResult")
+        .field("points", &SliceResult::points)
+        .field("polylineOffsets", &SliceResult::polylineOffsets)
+        .field("planeOffsets", &SliceResult::planeOffsets)
+        .field("closed", &SliceResult::closed);
+
+    // TopologyAdjacency：CSR 形式的邻接表，offsets 长度为 count + 1，第 i 项的邻居为 indices[offsets[i] .. offsets[i+1])
+    value_object<TopologyAdjacency>("TopologyAdjacency")
+        .field("offsets", &TopologyAdjacency::offsets)
+        .field("indices", &TopologyAdjacency::indices);
+
+    // 绑定 TopologyIndex 类（持久化拓扑索引，每个形状构建一次，交互选择时重复使用）
+    class_<TopologyIndex>("TopologyIndex")
+        .constructor<TopoDS_Shape>()
+        // shape() -> TopoDS_Shape：构建索引的原始形状
+        .function("shape", &TopologyIndex::shape)
+        // count(type) -> number：指定类型子形状的数量
+        .function("count", &TopologyIndex::count)
+        // indexOf(subShape) -> number：子形状在同类型中的序号（从 0 开始，与 fillet/chamfer 的边序号一致），不存在返回 -1
+        .function("indexOf", &TopologyIndex::indexOf)
+        // subShape(type, index) -> TopoDS_Shape：按序号取子形状，越界返回空形状
+        .function("subShape", &TopologyIndex::subShape)
+        // subShapes(type) -> ShapeArray：指定类型的全部子形状
+        .function("subShapes", &TopologyIndex::subShapes)
+        // ancestors(subShape, type) / descendants(subShape, type)：祖先 / 后代子形状（邻接表按类型对延迟构建并缓存）
+        .function("ancestors", &TopologyIndex::ancestors)
+        .function("descendants", &TopologyIndex::descendants)
+        // adjacencyArrays(from, to) -> TopologyAdjacency：导出两类子形状之间的完整邻接表（类型化数组）
+        .function("adjacencyArrays", &TopologyIndex::adjacencyArrays);
 }
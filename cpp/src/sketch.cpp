@@ -0,0 +1,751 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepLib_FindSurface.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BndLib_Add3dCurve.hxx>
+#include <Bnd_Box.hxx>
+#include <ElCLib.hxx>
+#include <Geom_Curve.hxx>
+#include <Geom_Plane.hxx>
+#include <IntTools_CommonPrt.hxx>
+#include <IntTools_EdgeEdge.hxx>
+#include <IntTools_Range.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopoDS_Wire.hxx>
+#include <gp_Ax3.hxx>
+#include <gp_Lin.hxx>
+#include <gp_Pln.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "shared.hpp"
+#include "utils.hpp"
+
+using namespace emscripten;
+
+struct EdgeIntersections {
+    /// @brief edges.length + 1 entries; the intersections of edge i are entries offsets[i] .. offsets[i + 1] - 1,
+    /// sorted by the parameter on edge i
+    Int32Array offsets;
+    /// @brief index of the other edge of every entry
+    Int32Array others;
+    /// @brief parameter on edge i followed by the parameter on the other edge, 2 per entry
+    Float64Array parameters;
+    /// @brief x, y, z per entry
+    Float64Array points;
+};
+
+/// @brief All-pairs intersections of a set of (coplanar) edges. Candidate pairs come from a sweep over the curve
+/// bounding boxes along their widest axis; line/line pairs are solved directly and every other pair, including
+/// collinear overlaps, goes to IntTools_EdgeEdge. Overlaps are reported at both ends of the common part.
+class EdgeArrangement {
+public:
+    struct Hit {
+        int edge;
+        int other;
+        double parameter;
+        double otherParameter;
+        gp_Pnt point;
+    };
+
+private:
+    struct EdgeData {
+        TopoDS_Edge edge;
+        BRepAdaptor_Curve curve;
+        double first = 0;
+        double last = 0;
+        Bnd_Box box;
+    };
+
+    std::vector<EdgeData> edges;
+    double tolerance;
+
+    std::vector<std::pair<int, int>> candidatePairs() const
+    {
+        Bnd_Box all;
+        for (const auto& data : edges) {
+            all.Add(data.box);
+        }
+        if (all.IsVoid()) {
+            return {};
+        }
+
+        double lower[3], upper[3];
+        all.Get(lower[0], lower[1], lower[2], upper[0], upper[1], upper[2]);
+        int axis = 0;
+        for (int i = 1; i < 3; i++) {
+            if (upper[i] - lower[i] > upper[axis] - lower[axis]) {
+                axis = i;
+            }
+        }
+
+        std::vector<double> minimum(edges.size()), maximum(edges.size());
+        std::vector<int> order;
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (edges[i].box.IsVoid()) {
+                continue;
+            }
+            double boxLower[3], boxUpper[3];
+            edges[i].box.Get(boxLower[0], boxLower[1], boxLower[2], boxUpper[0], boxUpper[1], boxUpper[2]);
+            minimum[i] = boxLower[axis];
+            maximum[i] = boxUpper[axis];
+            order.push_back(static_cast<int>(i));
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return minimum[a] < minimum[b]; });
+
+        std::vector<std::pair<int, int>> pairs;
+        for (size_t a = 0; a < order.size(); a++) {
+            int i = order[a];
+            for (size_t b = a + 1; b < order.size() && minimum[order[b]] <= maximum[i]; b++) {
+                int j = order[b];
+                if (!edges[i].box.IsOut(edges[j].box)) {
+                    pairs.emplace_back(std::min(i, j), std::max(i, j));
+                }
+            }
+        }
+        return pairs;
+    }
+
+    /// @brief closest points of two line segments; returns false for parallel lines so that collinear overlaps
+    /// are left to IntTools
+    bool intersectLines(int i, int j, std::vector<Hit>& hits) const
+    {
+        const auto& a = edges[i];
+        const auto& b = edges[j];
+        gp_Lin lineA = a.curve.Line(), lineB = b.curve.Line();
+        gp_XYZ dirA = lineA.Direction().XYZ(), dirB = lineB.Direction().XYZ();
+        gp_XYZ offset = lineA.Location().XYZ() - lineB.Location().XYZ();
+        double cosine = dirA.Dot(dirB);
+        double denominator = 1 - cosine * cosine;
+        if (denominator < Precision::Angular() * Precision::Angular()) {
+            return false;
+        }
+
+        double d = dirA.Dot(offset), e = dirB.Dot(offset);
+        double s = std::clamp((cosine * e - d) / denominator, a.first, a.last);
+        double t = std::clamp((e - cosine * d) / denominator, b.first, b.last);
+        gp_Pnt pointA = ElCLib::Value(s, lineA), pointB = ElCLib::Value(t, lineB);
+        if (pointA.Distance(pointB) <= tolerance) {
+            hits.push_back(Hit { i, j, s, t, pointA });
+        }
+        return true;
+    }
+
+    void intersectCurves(int i, int j, std::vector<Hit>& hits) const
+    {
+        IntTools_EdgeEdge intersector(edges[i].edge, edges[j].edge);
+        intersector.SetFuzzyValue(tolerance);
+        intersector.Perform();
+        if (!intersector.IsDone()) {
+            return;
+        }
+
+        // adaptors cache B-spline spans while evaluating, so each task evaluates on its own copies
+        BRepAdaptor_Curve curve(edges[i].edge), otherCurve(edges[j].edge);
+        const auto& parts = intersector.CommonParts();
+        for (int k = 1; k <= parts.Length(); k++) {
+            const IntTools_CommonPrt& part = parts(k);
+            if (part.Type() == TopAbs_VERTEX) {
+                double s = part.VertexParameter1(), t = part.VertexParameter2();
+                hits.push_back(Hit { i, j, s, t, curve.Value(s) });
+            } else if (part.Type() == TopAbs_EDGE && part.Ranges2().Length() > 0) {
+                const IntTools_Range& range2 = part.Ranges2()(1);
+                gp_Pnt start2 = otherCurve.Value(range2.First());
+                gp_Pnt end2 = otherCurve.Value(range2.Last());
+                for (double s : { part.Range1().First(), part.Range1().Last() }) {
+                    gp_Pnt point = curve.Value(s);
+                    double t = point.SquareDistance(start2) <= point.SquareDistance(end2) ? range2.First()
+                                                                                         : range2.Last();
+                    hits.push_back(Hit { i, j, s, t, point });
+                }
+            }
+        }
+    }
+
+public:
+    EdgeArrangement(const std::vector<TopoDS_Edge>& edgeVec, double tolerance)
+        : tolerance(tolerance > 0 ? tolerance : Precision::Confusion())
+    {
+        edges.reserve(edgeVec.size());
+        for (const auto& edge : edgeVec) {
+            auto& data = edges.emplace_back();
+            data.edge = edge;
+            if (edge.IsNull() || BRep_Tool::Degenerated(edge) || !BRep_Tool::IsGeometric(edge)) {
+                continue;
+            }
+            data.curve.Initialize(edge);
+            BRep_Tool::Range(edge, data.first, data.last);
+            BndLib_Add3dCurve::Add(data.curve, this->tolerance, data.box);
+        }
+    }
+
+    size_t size() const
+    {
+        return edges.size();
+    }
+
+    const TopoDS_Edge& edge(int index) const
+    {
+        return edges[index].edge;
+    }
+
+    /// @brief false for null and degenerated edges, which take no part in the arrangement
+    bool isValid(int index) const
+    {
+        return !edges[index].box.IsVoid();
+    }
+
+    double precision() const
+    {
+        return tolerance;
+    }
+
+    /// @brief every intersection twice, once from each edge, grouped by edge and sorted by parameter
+    std::vector<std::vector<Hit>> intersect() const
+    {
+        auto pairs = candidatePairs();
+        std::vector<std::vector<Hit>> pairHits(pairs.size());
+        OSD_Parallel::For(0, static_cast<int>(pairs.size()), [&](int index) {
+            auto [i, j] = pairs[index];
+            bool lines = edges[i].curve.GetType() == GeomAbs_Line && edges[j].curve.GetType() == GeomAbs_Line;
+            if (!lines || !intersectLines(i, j, pairHits[index])) {
+                intersectCurves(i, j, pairHits[index]);
+            }
+        });
+
+        std::vector<std::vector<Hit>> hits(edges.size());
+        for (const auto& list : pairHits) {
+            for (const auto& hit : list) {
+                hits[hit.edge].push_back(hit);
+                hits[hit.other].push_back(Hit { hit.other, hit.edge, hit.otherParameter, hit.parameter, hit.point });
+            }
+        }
+        for (auto& list : hits) {
+            std::sort(list.begin(), list.end(), [](const Hit& a, const Hit& b) { return a.parameter < b.parameter; });
+        }
+        return hits;
+    }
+};
+
+/// @brief Minimal closed regions of a set of coplanar edges. The edges are split at their intersections,
+/// endpoints closer than the tolerance are merged and dangling edges are pruned. The remaining planar graph is
+/// traversed keeping the face on the left and each boundary is split at its bridge edges: counter-clockwise
+/// cycles bound regions, clockwise cycles split off a region's boundary are its holes, and the other clockwise
+/// cycles are the outer boundaries of connected components and become holes of the smallest region of another
+/// component containing them.
+class RegionFinder {
+    struct SubEdge {
+        TopoDS_Edge edge;
+        int start;
+        int end;
+        double first;
+        double last;
+    };
+
+    /// @brief half-edge 2 * i runs along sub-edge i, 2 * i + 1 against it
+    struct HalfEdge {
+        int origin;
+        int target;
+        /// @brief leaving direction quantized to Precision::Angular steps in [0, 2 pi), so tangent directions
+        /// compare exactly, also across the +-pi wrap
+        long long direction;
+        double curvature;
+        bool removed;
+    };
+
+    struct Cycle {
+        std::vector<int> halfEdges;
+        std::vector<gp_XY> polygon;
+        double area;
+        int component;
+        /// @brief index of the traced face boundary the cycle was split from
+        int trace;
+    };
+
+    const EdgeArrangement& arrangement;
+    double tolerance;
+    gp_Ax3 plane;
+    std::vector<TopoDS_Vertex> vertices;
+    std::vector<gp_Pnt> vertexPoints;
+    std::unordered_map<long long, std::vector<int>> vertexGrid;
+    std::vector<SubEdge> subEdges;
+    std::vector<HalfEdge> halfEdges;
+
+    static constexpr int CURVE_SAMPLES = 16;
+
+    gp_XY toPlane(const gp_Pnt& point) const
+    {
+        gp_Vec offset(plane.Location(), point);
+        return gp_XY(offset.Dot(plane.XDirection()), offset.Dot(plane.YDirection()));
+    }
+
+    long long cellKey(long long x, long long y, long long z) const
+    {
+        return (x * 73856093) ^ (y * 19349663) ^ (z * 83492791);
+    }
+
+    int findOrAddVertex(const gp_Pnt& point)
+    {
+        double cell = tolerance * 2;
+        long long x = std::llround(point.X() / cell), y = std::llround(point.Y() / cell),
+                  z = std::llround(point.Z() / cell);
+        for (long long i = x - 1; i <= x + 1; i++) {
+            for (long long j = y - 1; j <= y + 1; j++) {
+                for (long long k = z - 1; k <= z + 1; k++) {
+                    auto it = vertexGrid.find(cellKey(i, j, k));
+                    if (it == vertexGrid.end()) {
+                        continue;
+                    }
+                    for (int index : it->second) {
+                        if (vertexPoints[index].Distance(point) <= tolerance) {
+                            return index;
+                        }
+                    }
+                }
+            }
+        }
+
+        TopoDS_Vertex vertex;
+        BRep_Builder().MakeVertex(vertex, point, tolerance * 2);
+        vertices.push_back(vertex);
+        vertexPoints.push_back(point);
+        vertexGrid[cellKey(x, y, z)].push_back(static_cast<int>(vertices.size()) - 1);
+        return static_cast<int>(vertices.size()) - 1;
+    }
+
+    void splitEdge(int index, std::vector<EdgeArrangement::Hit> hits,
+        std::unordered_map<long long, std::vector<gp_Pnt>>& midpoints)
+    {
+        TopLoc_Location location;
+        double first, last;
+        Handle(Geom_Curve) curve = BRep_Tool::Curve(arrangement.edge(index), location, first, last);
+        if (curve.IsNull()) {
+            return;
+        }
+        if (!location.IsIdentity()) {
+            const gp_Trsf& trsf = location.Transformation();
+            first = curve->TransformedParameter(first, trsf);
+            last = curve->TransformedParameter(last, trsf);
+            for (auto& hit : hits) {
+                hit.parameter = curve->TransformedParameter(hit.parameter, trsf);
+            }
+            curve = Handle(Geom_Curve)::DownCast(curve->Transformed(trsf));
+        }
+
+        std::vector<std::pair<double, int>> splits { { first, findOrAddVertex(curve->Value(first)) } };
+        for (const auto& hit : hits) {
+            splits.emplace_back(std::clamp(hit.parameter, first, last), findOrAddVertex(hit.point));
+        }
+        splits.emplace_back(last, findOrAddVertex(curve->Value(last)));
+        std::sort(splits.begin() + 1, splits.end() - 1);
+
+        for (size_t k = 0; k + 1 < splits.size(); k++) {
+            auto [p1, v1] = splits[k];
+            auto [p2, v2] = splits[k + 1];
+            gp_Pnt middle = curve->Value((p1 + p2) / 2);
+            if (p2 - p1 <= Precision::PConfusion()
+                || (v1 == v2 && middle.Distance(vertexPoints[v1]) <= tolerance)) {
+                continue;
+            }
+
+            auto& existing = midpoints[(static_cast<long long>(std::min(v1, v2)) << 32) | std::max(v1, v2)];
+            bool duplicated = std::any_of(existing.begin(), existing.end(),
+                [&](const gp_Pnt& point) { return point.Distance(middle) <= tolerance * 2; });
+            if (duplicated) {
+                continue;
+            }
+
+            // built directly so that merged vertices within the tolerance never make the edge fail
+            BRep_Builder builder;
+            TopoDS_Edge edge;
+            builder.MakeEdge(edge, curve, tolerance);
+            builder.Add(edge, vertices[v1].Oriented(TopAbs_FORWARD));
+            builder.Add(edge, vertices[v2].Oriented(TopAbs_REVERSED));
+            builder.Range(edge, p1, p2);
+            existing.push_back(middle);
+            subEdges.push_back(SubEdge { edge, v1, v2, p1, p2 });
+        }
+    }
+
+    /// @brief direction and signed curvature leaving the origin of the half-edge, in plane coordinates
+    void setDirection(HalfEdge& halfEdge, const SubEdge& subEdge, bool forward) const
+    {
+        BRepAdaptor_Curve curve(subEdge.edge);
+        gp_Pnt point;
+        gp_Vec d1, d2;
+        curve.D2(forward ? subEdge.first : subEdge.last, point, d1, d2);
+        if (!forward) {
+            d1.Reverse();
+        }
+        gp_XY tangent(d1.Dot(plane.XDirection()), d1.Dot(plane.YDirection()));
+        gp_XY second(d2.Dot(plane.XDirection()), d2.Dot(plane.YDirection()));
+        double length = tangent.Modulus();
+        double angle = std::atan2(tangent.Y(), tangent.X()) + M_PI;
+        halfEdge.direction = std::llround(angle / Precision::Angular()) % std::llround(2 * M_PI / Precision::Angular());
+        halfEdge.curvature = length > 0 ? (tangent ^ second) / (length * length * length) : 0;
+    }
+
+    void buildHalfEdges()
+    {
+        halfEdges.reserve(subEdges.size() * 2);
+        for (const auto& subEdge : subEdges) {
+            HalfEdge forward { subEdge.start, subEdge.end, 0, 0, false };
+            HalfEdge backward { subEdge.end, subEdge.start, 0, 0, false };
+            setDirection(forward, subEdge, true);
+            setDirection(backward, subEdge, false);
+            halfEdges.push_back(forward);
+            halfEdges.push_back(backward);
+        }
+    }
+
+    void pruneDanglingEdges()
+    {
+        std::vector<int> degree(vertices.size(), 0);
+        std::vector<std::vector<int>> outgoing(vertices.size());
+        for (size_t h = 0; h < halfEdges.size(); h++) {
+            degree[halfEdges[h].origin]++;
+            outgoing[halfEdges[h].origin].push_back(static_cast<int>(h));
+        }
+
+        std::vector<int> stack;
+        for (size_t v = 0; v < vertices.size(); v++) {
+            if (degree[v] == 1) {
+                stack.push_back(static_cast<int>(v));
+            }
+        }
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int h : outgoing[v]) {
+                if (halfEdges[h].removed) {
+                    continue;
+                }
+                halfEdges[h].removed = halfEdges[h ^ 1].removed = true;
+                degree[v]--;
+                if (--degree[halfEdges[h].target] == 1) {
+                    stack.push_back(halfEdges[h].target);
+                }
+            }
+        }
+    }
+
+    /// @brief next half-edge keeping the face on the left: the outgoing half-edge just before the twin in
+    /// counter-clockwise order around the target vertex
+    std::vector<int> linkHalfEdges() const
+    {
+        std::vector<std::vector<int>> outgoing(vertices.size());
+        for (size_t h = 0; h < halfEdges.size(); h++) {
+            if (!halfEdges[h].removed) {
+                outgoing[halfEdges[h].origin].push_back(static_cast<int>(h));
+            }
+        }
+
+        std::vector<int> position(halfEdges.size(), -1);
+        for (auto& list : outgoing) {
+            std::sort(list.begin(), list.end(), [&](int a, int b) {
+                const auto& first = halfEdges[a];
+                const auto& second = halfEdges[b];
+                return std::tie(first.direction, first.curvature, a) < std::tie(second.direction, second.curvature, b);
+            });
+            for (size_t i = 0; i < list.size(); i++) {
+                position[list[i]] = static_cast<int>(i);
+            }
+        }
+
+        std::vector<int> next(halfEdges.size(), -1);
+        for (size_t h = 0; h < halfEdges.size(); h++) {
+            if (halfEdges[h].removed) {
+                continue;
+            }
+            const auto& around = outgoing[halfEdges[h].target];
+            int twin = position[h ^ 1];
+            next[h] = around[(twin + around.size() - 1) % around.size()];
+        }
+        return next;
+    }
+
+    void appendPolygon(int h, std::vector<gp_XY>& polygon) const
+    {
+        const auto& subEdge = subEdges[h / 2];
+        bool forward = (h & 1) == 0;
+        BRepAdaptor_Curve curve(subEdge.edge);
+        int samples = curve.GetType() == GeomAbs_Line ? 1 : CURVE_SAMPLES;
+        for (int i = 0; i < samples; i++) {
+            double t = static_cast<double>(i) / samples;
+            double parameter = forward ? subEdge.first + (subEdge.last - subEdge.first) * t
+                                       : subEdge.last - (subEdge.last - subEdge.first) * t;
+            polygon.push_back(toPlane(curve.Value(parameter)));
+        }
+    }
+
+    static double signedArea(const std::vector<gp_XY>& polygon)
+    {
+        double area = 0;
+        for (size_t i = 0; i < polygon.size(); i++) {
+            area += polygon[i] ^ polygon[(i + 1) % polygon.size()];
+        }
+        return area / 2;
+    }
+
+    static bool contains(const std::vector<gp_XY>& polygon, const gp_XY& point)
+    {
+        bool inside = false;
+        for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            const gp_XY& a = polygon[i];
+            const gp_XY& b = polygon[j];
+            if ((a.Y() > point.Y()) != (b.Y() > point.Y())
+                && point.X() < (b.X() - a.X()) * (point.Y() - a.Y()) / (b.Y() - a.Y()) + a.X()) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    std::vector<int> components() const
+    {
+        std::vector<int> parent(vertices.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](int v) {
+            while (parent[v] != v) {
+                v = parent[v] = parent[parent[v]];
+            }
+            return v;
+        };
+        for (size_t h = 0; h < halfEdges.size(); h += 2) {
+            if (!halfEdges[h].removed) {
+                parent[find(halfEdges[h].origin)] = find(halfEdges[h].target);
+            }
+        }
+        for (size_t v = 0; v < vertices.size(); v++) {
+            parent[v] = find(static_cast<int>(v));
+        }
+        return parent;
+    }
+
+    /// @brief A bridge edge, e.g. one joining an inner loop to the outer boundary, is walked in both directions
+    /// by the same face boundary. Dropping both half-edges splits the boundary into closed loops; bridges of a
+    /// planar face nest like parentheses, so the loop between the two half-edges is completed when the second
+    /// one is reached.
+    static std::vector<std::vector<int>> splitAtBridges(const std::vector<int>& trace)
+    {
+        std::unordered_set<int> inTrace(trace.begin(), trace.end());
+        std::unordered_set<int> opened;
+        std::vector<std::vector<int>> loops;
+        std::vector<std::vector<int>> open(1);
+        for (int h : trace) {
+            if (inTrace.count(h ^ 1) == 0) {
+                open.back().push_back(h);
+            } else if (opened.count(h ^ 1) == 0) {
+                opened.insert(h);
+                open.emplace_back();
+            } else if (open.size() > 1) {
+                loops.push_back(std::move(open.back()));
+                open.pop_back();
+            }
+        }
+        for (auto& loop : open) {
+            loops.push_back(std::move(loop));
+        }
+        loops.erase(std::remove_if(loops.begin(), loops.end(), [](const auto& loop) { return loop.empty(); }),
+            loops.end());
+        return loops;
+    }
+
+    std::vector<Cycle> traceCycles() const
+    {
+        auto next = linkHalfEdges();
+        auto component = components();
+        std::vector<bool> visited(halfEdges.size(), false);
+        std::vector<Cycle> cycles;
+        int traceCount = 0;
+        for (size_t start = 0; start < halfEdges.size(); start++) {
+            if (halfEdges[start].removed || visited[start]) {
+                continue;
+            }
+
+            std::vector<int> trace;
+            for (int h = static_cast<int>(start); h >= 0 && !visited[h]; h = next[h]) {
+                visited[h] = true;
+                trace.push_back(h);
+            }
+            for (auto& loop : splitAtBridges(trace)) {
+                Cycle cycle { std::move(loop), {}, 0, component[halfEdges[start].origin], traceCount };
+                for (int h : cycle.halfEdges) {
+                    appendPolygon(h, cycle.polygon);
+                }
+                cycle.area = signedArea(cycle.polygon);
+                cycles.push_back(std::move(cycle));
+            }
+            traceCount++;
+        }
+        return cycles;
+    }
+
+    TopoDS_Wire makeWire(const Cycle& cycle) const
+    {
+        BRep_Builder builder;
+        TopoDS_Wire wire;
+        builder.MakeWire(wire);
+        for (int h : cycle.halfEdges) {
+            const auto& edge = subEdges[h / 2].edge;
+            builder.Add(wire, (h & 1) == 0 ? edge : TopoDS::Edge(edge.Reversed()));
+        }
+        wire.Closed(true);
+        return wire;
+    }
+
+public:
+    RegionFinder(const EdgeArrangement& arrangement, const gp_Ax3& plane)
+        : arrangement(arrangement)
+        , tolerance(arrangement.precision())
+        , plane(plane)
+    {
+    }
+
+    std::vector<TopoDS_Face> faces()
+    {
+        auto hits = arrangement.intersect();
+        std::unordered_map<long long, std::vector<gp_Pnt>> midpoints;
+        for (size_t i = 0; i < arrangement.size(); i++) {
+            if (arrangement.isValid(static_cast<int>(i))) {
+                splitEdge(static_cast<int>(i), hits[i], midpoints);
+            }
+        }
+        buildHalfEdges();
+        pruneDanglingEdges();
+        auto cycles = traceCycles();
+
+        std::vector<int> regions, boundaries;
+        for (size_t i = 0; i < cycles.size(); i++) {
+            (cycles[i].area > 0 ? regions : boundaries).push_back(static_cast<int>(i));
+        }
+        std::sort(regions.begin(), regions.end(), [&](int a, int b) { return cycles[a].area < cycles[b].area; });
+
+        std::vector<std::vector<int>> holes(cycles.size());
+        std::unordered_map<int, int> regionOfTrace;
+        for (int region : regions) {
+            regionOfTrace[cycles[region].trace] = region;
+        }
+        for (int boundary : boundaries) {
+            // a loop split off a region's own boundary at a bridge is a hole of that region
+            auto owner = regionOfTrace.find(cycles[boundary].trace);
+            if (owner != regionOfTrace.end()) {
+                holes[owner->second].push_back(boundary);
+                continue;
+            }
+
+            const auto& sample = cycles[boundary].polygon.front();
+            for (int region : regions) {
+                if (cycles[region].component != cycles[boundary].component
+                    && contains(cycles[region].polygon, sample)) {
+                    holes[region].push_back(boundary);
+                    break;
+                }
+            }
+        }
+
+        std::vector<TopoDS_Face> faces;
+        gp_Pln pln(plane);
+        for (int region : regions) {
+            BRepBuilderAPI_MakeFace builder(pln, makeWire(cycles[region]), true);
+            for (int hole : holes[region]) {
+                builder.Add(makeWire(cycles[hole]));
+            }
+            if (builder.IsDone()) {
+                faces.push_back(builder.Face());
+            }
+        }
+        return faces;
+    }
+};
+
+class Sketch {
+public:
+    /// @brief all intersections between the edges in one call, replacing pairwise Edge.intersect calls
+    static EdgeIntersections intersections(const EdgeArray& edges, double tolerance)
+    {
+        EdgeArrangement arrangement(vecFromJSArray<TopoDS_Edge>(edges), tolerance);
+        auto hits = arrangement.intersect();
+
+        std::vector<int> offsets { 0 }, others;
+        std::vector<double> parameters, points;
+        for (const auto& list : hits) {
+            for (const auto& hit : list) {
+                others.push_back(hit.other);
+                parameters.insert(parameters.end(), { hit.parameter, hit.otherParameter });
+                points.insert(points.end(), { hit.point.X(), hit.point.Y(), hit.point.Z() });
+            }
+            offsets.push_back(static_cast<int>(others.size()));
+        }
+
+        return EdgeIntersections { toTypedArray<Int32Array>(offsets), toTypedArray<Int32Array>(others),
+            toTypedArray<Float64Array>(parameters), toTypedArray<Float64Array>(points) };
+    }
+
+    /// @brief every minimal closed region bounded by the edges as a planar face, with nested loops as holes
+    static FaceArray regions(const EdgeArray& edges, double tolerance)
+    {
+        auto edgeVec = vecFromJSArray<TopoDS_Edge>(edges);
+        BRep_Builder builder;
+        TopoDS_Compound compound;
+        builder.MakeCompound(compound);
+        for (const auto& edge : edgeVec) {
+            builder.Add(compound, edge);
+        }
+
+        BRepLib_FindSurface findPlane(compound, std::max(tolerance, Precision::Confusion()), true);
+        if (!findPlane.Found()) {
+            return FaceArray(val::array());
+        }
+        auto surface = Handle(Geom_Plane)::DownCast(findPlane.Surface());
+        if (surface.IsNull()) {
+            return FaceArray(val::array());
+        }
+        const gp_Ax3& position = surface->Position();
+        gp_Ax3 plane(position.Location(), position.XDirection().Crossed(position.YDirection()),
+            position.XDirection());
+
+        EdgeArrangement arrangement(edgeVec, tolerance);
+        auto faces = RegionFinder(arrangement, plane).faces();
+        return FaceArray(val::array(faces));
+    }
+};
+
+EMSCRIPTEN_BINDINGS(Sketch)
+{
+    // EdgeIntersections：按边分组的交点结果，边 i 的交点为 offsets[i] 到 offsets[i + 1] - 1，按边 i 上的参数排序
+    value_object<EdgeIntersections>("EdgeIntersections")
+        .field("offsets", &EdgeIntersections::offsets)
+        .field("others", &EdgeIntersections::others)
+        .field("parameters", &EdgeIntersections::parameters)
+        .field("points", &EdgeIntersections::points);
+
+    // 绑定 Sketch 类（草图求交 / 区域识别）
+    class_<Sketch>("Sketch")
+        // intersections(edges, tolerance) -> EdgeIntersections：一次计算所有边两两之间的交点。
+        // 先用包围盒扫描线剔除，直线对直接求解，其余（含共线重叠）使用 IntTools_EdgeEdge
+        .class_function("intersections", &Sketch::intersections)
+        // regions(edges, tolerance) -> FaceArray：从任意共面边集合中识别所有最小封闭区域并生成面。
+        // 边在交点处打断、端点按容差合并、悬挂边被剔除，嵌套的封闭环作为孔
+        .class_function("regions", &Sketch::regions);
+}
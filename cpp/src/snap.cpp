@@ -0,0 +1,641 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepExtrema_ExtCC.hxx>
+#include <BRep_Tool.hxx>
+#include <Extrema_LocateExtPC.hxx>
+#include <GCPnts_AbscissaPoint.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "shared.hpp"
+#include "utils.hpp"
+
+using namespace emscripten;
+
+/// @brief snap kinds, also used as bit flags for the types mask of the queries
+enum class SnapType {
+    Endpoint = 1,
+    Midpoint = 2,
+    Center = 4,
+    Intersection = 8,
+    Nearest = 16,
+};
+
+struct SnapResult {
+    bool found;
+    SnapType type;
+    /// @brief id returned by insert, -1 when nothing was found
+    int shapeId;
+    /// @brief 0-based edge index in TopExp::MapShapes order, -1 for vertices
+    int edgeIndex;
+    Vector3 point;
+    /// @brief curve parameter on the edge, 0 for vertices
+    double parameter;
+    /// @brief distance to the query point or ray
+    double distance;
+};
+
+/// @brief Median-split tree over axis-aligned boxes stored in one flat array. Over points (zero sized boxes) it is
+/// a KD-tree, over curve segments a BVH.
+class BoxTree {
+    struct Node {
+        std::array<double, 6> box;
+        /// @brief leaves: first item and item count; inner nodes: index of the right child (left is next) and 0
+        int start;
+        int count;
+    };
+
+    static constexpr int LEAF_SIZE = 4;
+
+    std::vector<Node> nodes;
+    std::vector<int> items;
+
+    static void merge(std::array<double, 6>& box, const std::array<double, 6>& other)
+    {
+        for (int i = 0; i < 3; i++) {
+            box[i] = std::min(box[i], other[i]);
+            box[i + 3] = std::max(box[i + 3], other[i + 3]);
+        }
+    }
+
+    void build(const std::vector<std::array<double, 6>>& boxes, int start, int end)
+    {
+        int node = static_cast<int>(nodes.size());
+        nodes.push_back(Node { boxes[items[start]], start, end - start });
+        for (int i = start + 1; i < end; i++) {
+            merge(nodes[node].box, boxes[items[i]]);
+        }
+        if (end - start <= LEAF_SIZE) {
+            return;
+        }
+
+        const auto& box = nodes[node].box;
+        int axis = 0;
+        for (int i = 1; i < 3; i++) {
+            if (box[i + 3] - box[i] > box[axis + 3] - box[axis]) {
+                axis = i;
+            }
+        }
+        int middle = (start + end) / 2;
+        std::nth_element(items.begin() + start, items.begin() + middle, items.begin() + end, [&](int a, int b) {
+            return boxes[a][axis] + boxes[a][axis + 3] < boxes[b][axis] + boxes[b][axis + 3];
+        });
+
+        build(boxes, start, middle);
+        nodes[node].start = static_cast<int>(nodes.size());
+        nodes[node].count = 0;
+        build(boxes, middle, end);
+    }
+
+public:
+    void build(const std::vector<std::array<double, 6>>& boxes)
+    {
+        nodes.clear();
+        items.resize(boxes.size());
+        for (size_t i = 0; i < boxes.size(); i++) {
+            items[i] = static_cast<int>(i);
+        }
+        if (!boxes.empty()) {
+            build(boxes, 0, static_cast<int>(boxes.size()));
+        }
+    }
+
+    /// @brief visits the items of every leaf whose box passes accept
+    template <typename Accept, typename Visit>
+    void query(const Accept& accept, const Visit& visit) const
+    {
+        if (nodes.empty()) {
+            return;
+        }
+
+        int stack[64];
+        int size = 0;
+        stack[size++] = 0;
+        while (size > 0) {
+            const Node& node = nodes[stack[--size]];
+            if (!accept(node.box)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (int i = node.start; i < node.start + node.count; i++) {
+                    visit(items[i]);
+                }
+            } else {
+                stack[size++] = node.start;
+                stack[size++] = static_cast<int>(&node - nodes.data()) + 1;
+            }
+        }
+    }
+};
+
+/// @brief Persistent snap index for sketching and measuring. Key points (vertices, arc-length midpoints, circle and
+/// ellipse centers and edge/edge intersections) live in a KD-tree, the edges discretized with the mesher deflection
+/// live in a BVH of segments for nearest-on-curve. Shapes can be inserted and removed at any time; the trees are
+/// rebuilt lazily on the next query, inserts only build a small tree over the segments not indexed yet.
+class SnapIndex {
+    struct ShapeEntry {
+        TopoDS_Shape shape;
+        /// @brief per edge index, null for degenerated edges
+        std::vector<Handle(BRepAdaptor_Curve)> curves;
+        double deflection;
+    };
+
+    struct KeyPoint {
+        gp_Pnt point;
+        SnapType type;
+        int shapeId;
+        int edgeIndex;
+        double parameter;
+        /// @brief the second shape of an intersection, so that removing either one drops the point
+        int otherShapeId;
+    };
+
+    struct Segment {
+        gp_Pnt start;
+        gp_Pnt end;
+        double startParameter;
+        double endParameter;
+        int shapeId;
+        int edgeIndex;
+    };
+
+    struct Candidate {
+        double distance = std::numeric_limits<double>::max();
+        /// @brief position along the ray, closer to the eye wins between equally distant candidates
+        double depth = 0;
+        SnapResult result { false, SnapType::Nearest, -1, -1, Vector3 { 0, 0, 0 }, 0, 0 };
+
+        bool offer(double candidateDistance, double candidateDepth)
+        {
+            if (candidateDistance < distance - Precision::Confusion()
+                || (candidateDistance <= distance + Precision::Confusion() && candidateDepth < depth)) {
+                distance = candidateDistance;
+                depth = candidateDepth;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    double lineDeflection;
+    int nextId = 0;
+    std::unordered_map<int, ShapeEntry> shapes;
+    std::vector<KeyPoint> points;
+    std::vector<Segment> segments;
+    BoxTree pointTree;
+    /// @brief over segments [0, indexedSegments), the later ones wait for the next query
+    BoxTree segmentTree;
+    size_t indexedSegments = 0;
+    bool pointsDirty = false;
+
+    static std::array<double, 6> segmentBox(const Segment& segment)
+    {
+        return { std::min(segment.start.X(), segment.end.X()), std::min(segment.start.Y(), segment.end.Y()),
+            std::min(segment.start.Z(), segment.end.Z()), std::max(segment.start.X(), segment.end.X()),
+            std::max(segment.start.Y(), segment.end.Y()), std::max(segment.start.Z(), segment.end.Z()) };
+    }
+
+    void ensureTrees()
+    {
+        if (pointsDirty) {
+            std::vector<std::array<double, 6>> boxes;
+            boxes.reserve(points.size());
+            for (const auto& key : points) {
+                boxes.push_back({ key.point.X(), key.point.Y(), key.point.Z(), key.point.X(), key.point.Y(),
+                    key.point.Z() });
+            }
+            pointTree.build(boxes);
+            pointsDirty = false;
+        }
+        if (indexedSegments != segments.size()) {
+            indexSegments();
+        }
+    }
+
+    void indexSegments()
+    {
+        std::vector<std::array<double, 6>> boxes;
+        boxes.reserve(segments.size());
+        for (const auto& segment : segments) {
+            boxes.push_back(segmentBox(segment));
+        }
+        segmentTree.build(boxes);
+        indexedSegments = segments.size();
+    }
+
+    void dropSegmentTree()
+    {
+        segmentTree = BoxTree();
+        indexedSegments = 0;
+    }
+
+    static double boxDistance(const std::array<double, 6>& box, const gp_Pnt& point)
+    {
+        double coords[] = { point.X(), point.Y(), point.Z() };
+        double square = 0;
+        for (int i = 0; i < 3; i++) {
+            double gap = std::max({ box[i] - coords[i], coords[i] - box[i + 3], 0.0 });
+            square += gap * gap;
+        }
+        return std::sqrt(square);
+    }
+
+    /// @brief slab test of the ray against the box grown by radius
+    static bool rayHitsBox(const std::array<double, 6>& box, const gp_Pnt& origin, const gp_Dir& direction,
+        double radius)
+    {
+        double coords[] = { origin.X(), origin.Y(), origin.Z() };
+        double dirs[] = { direction.X(), direction.Y(), direction.Z() };
+        double near = 0, far = std::numeric_limits<double>::max();
+        for (int i = 0; i < 3; i++) {
+            double lower = box[i] - radius, upper = box[i + 3] + radius;
+            if (std::abs(dirs[i]) < 1e-12) {
+                if (coords[i] < lower || coords[i] > upper) {
+                    return false;
+                }
+                continue;
+            }
+            double t1 = (lower - coords[i]) / dirs[i], t2 = (upper - coords[i]) / dirs[i];
+            near = std::max(near, std::min(t1, t2));
+            far = std::min(far, std::max(t1, t2));
+            if (near > far) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static double rayDistance(const gp_Pnt& point, const gp_Pnt& origin, const gp_Dir& direction, double& depth)
+    {
+        depth = std::max(0.0, gp_Vec(origin, point).Dot(gp_Vec(direction)));
+        return point.Distance(origin.Translated(gp_Vec(direction) * depth));
+    }
+
+    /// @brief closest points between a segment and a ray; returns the segment fraction and the ray depth
+    static void closestSegmentRay(const Segment& segment, const gp_Pnt& origin, const gp_Dir& direction,
+        double& fraction, double& depth)
+    {
+        gp_Vec d1(segment.start, segment.end), d2(direction), r(origin, segment.start);
+        double a = d1.SquareMagnitude(), f = d2.Dot(r);
+        if (a <= Precision::SquareConfusion()) {
+            fraction = 0;
+            depth = std::max(0.0, f);
+            return;
+        }
+        double b = d1.Dot(d2), c = d1.Dot(r), denominator = a - b * b;
+        fraction = denominator > Precision::SquareConfusion() ? std::clamp((b * f - c) / denominator, 0.0, 1.0) : 0;
+        depth = b * fraction + f;
+        if (depth < 0) {
+            depth = 0;
+            fraction = std::clamp(-c / a, 0.0, 1.0);
+        }
+    }
+
+    static double segmentFraction(const Segment& segment, const gp_Pnt& point)
+    {
+        gp_Vec d(segment.start, segment.end);
+        double square = d.SquareMagnitude();
+        return square > 0 ? std::clamp(gp_Vec(segment.start, point).Dot(d) / square, 0.0, 1.0) : 0;
+    }
+
+    /// @brief polishes a point found on the discretization onto the curve, starting from the segment parameter
+    SnapResult onCurve(const Segment& segment, double fraction, const gp_Pnt& target) const
+    {
+        const auto& curve = *shapes.at(segment.shapeId).curves[segment.edgeIndex];
+        double parameter = segment.startParameter + (segment.endParameter - segment.startParameter) * fraction;
+        gp_Pnt point = curve.Value(parameter);
+        Extrema_LocateExtPC locate(target, curve, parameter, Precision::PConfusion());
+        if (locate.IsDone()) {
+            double located = locate.Point().Parameter();
+            if (located >= curve.FirstParameter() && located <= curve.LastParameter()) {
+                parameter = located;
+                point = locate.Point().Value();
+            }
+        }
+        return SnapResult { true, SnapType::Nearest, segment.shapeId, segment.edgeIndex, Vector3::fromPnt(point),
+            parameter, 0 };
+    }
+
+    void addKeyPoint(const gp_Pnt& point, SnapType type, int shapeId, int edgeIndex, double parameter,
+        int otherShapeId = -1)
+    {
+        points.push_back(KeyPoint { point, type, shapeId, edgeIndex, parameter, otherShapeId });
+    }
+
+    void addEdge(int id, int edgeIndex, const BRepAdaptor_Curve& curve, double deflection)
+    {
+        double first = curve.FirstParameter(), last = curve.LastParameter();
+        if (curve.GetType() == GeomAbs_Line) {
+            addKeyPoint(curve.Value((first + last) / 2), SnapType::Midpoint, id, edgeIndex, (first + last) / 2);
+        } else {
+            double length = GCPnts_AbscissaPoint::Length(curve, first, last);
+            GCPnts_AbscissaPoint middle(curve, length / 2, first);
+            if (middle.IsDone()) {
+                addKeyPoint(curve.Value(middle.Parameter()), SnapType::Midpoint, id, edgeIndex, middle.Parameter());
+            }
+        }
+        if (curve.GetType() == GeomAbs_Circle) {
+            addKeyPoint(curve.Circle().Location(), SnapType::Center, id, edgeIndex, 0);
+        } else if (curve.GetType() == GeomAbs_Ellipse) {
+            addKeyPoint(curve.Ellipse().Location(), SnapType::Center, id, edgeIndex, 0);
+        }
+
+        GCPnts_TangentialDeflection discretizer(curve, ANGLE_DEFLECTION, deflection);
+        for (int i = 1; i < discretizer.NbPoints(); i++) {
+            segments.push_back(Segment { discretizer.Value(i), discretizer.Value(i + 1), discretizer.Parameter(i),
+                discretizer.Parameter(i + 1), id, edgeIndex });
+        }
+    }
+
+    /// @brief edge pairs whose discretizations come close are intersected exactly, like Edge.intersect. The segments
+    /// from firstSegment on are new: they are tested against the segment tree and a small tree over the segments not
+    /// indexed yet. The segment tree is only rebuilt once the waiting segments outgrow the square root of its size,
+    /// so a run of inserts without queries stays well below one rebuild per shape.
+    void addIntersections(size_t firstSegment)
+    {
+        size_t waiting = firstSegment - indexedSegments;
+        if (waiting * waiting > indexedSegments) {
+            indexSegments();
+        }
+
+        std::vector<std::array<double, 6>> boxes;
+        boxes.reserve(segments.size() - indexedSegments);
+        for (size_t i = indexedSegments; i < segments.size(); i++) {
+            boxes.push_back(segmentBox(segments[i]));
+        }
+        BoxTree pendingTree;
+        pendingTree.build(boxes);
+
+        std::set<std::array<int, 4>> pairs;
+        for (size_t i = firstSegment; i < segments.size(); i++) {
+            const auto& segment = segments[i];
+            double gap = std::max(shapes.at(segment.shapeId).deflection, Precision::Confusion());
+            auto box = segmentBox(segment);
+            auto near = [&](const std::array<double, 6>& node) {
+                for (int axis = 0; axis < 3; axis++) {
+                    if (node[axis] > box[axis + 3] + gap || node[axis + 3] < box[axis] - gap) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            auto collect = [&](size_t index) {
+                const auto& other = segments[index];
+                if (other.shapeId == segment.shapeId && other.edgeIndex == segment.edgeIndex) {
+                    return;
+                }
+                if (std::tie(segment.shapeId, segment.edgeIndex) < std::tie(other.shapeId, other.edgeIndex)) {
+                    pairs.insert({ segment.shapeId, segment.edgeIndex, other.shapeId, other.edgeIndex });
+                } else {
+                    pairs.insert({ other.shapeId, other.edgeIndex, segment.shapeId, segment.edgeIndex });
+                }
+            };
+            segmentTree.query(near, [&](int index) { collect(index); });
+            pendingTree.query(near, [&](int index) { collect(indexedSegments + index); });
+        }
+
+        for (const auto& [shapeId, edgeIndex, otherShapeId, otherEdgeIndex] : pairs) {
+            const auto& edge = shapes.at(shapeId).curves[edgeIndex]->Edge();
+            const auto& otherEdge = shapes.at(otherShapeId).curves[otherEdgeIndex]->Edge();
+            BRepExtrema_ExtCC cc(edge, otherEdge);
+            if (!cc.IsDone() || cc.IsParallel()) {
+                continue;
+            }
+            for (int i = 1; i <= cc.NbExt(); i++) {
+                if (cc.SquareDistance(i) <= Precision::Intersection()) {
+                    addKeyPoint(cc.PointOnE1(i), SnapType::Intersection, shapeId, edgeIndex, cc.ParameterOnE1(i),
+                        otherShapeId);
+                }
+            }
+        }
+    }
+
+    /// @brief adds the key points and segments of the shape, without intersections
+    int addShape(const TopoDS_Shape& shape)
+    {
+        int id = nextId++;
+        auto& entry = shapes[id];
+        entry.shape = shape;
+        entry.deflection = boundingBoxRatio(shape, lineDeflection);
+
+        TopTools_IndexedMapOfShape vertexMap, edgeMap;
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+        for (int i = 1; i <= vertexMap.Extent(); i++) {
+            addKeyPoint(BRep_Tool::Pnt(TopoDS::Vertex(vertexMap(i))), SnapType::Endpoint, id, -1, 0);
+        }
+
+        entry.curves.resize(edgeMap.Extent());
+        for (int i = 1; i <= edgeMap.Extent(); i++) {
+            const auto& edge = TopoDS::Edge(edgeMap(i));
+            if (BRep_Tool::Degenerated(edge) || !BRep_Tool::IsGeometric(edge)) {
+                continue;
+            }
+            entry.curves[i - 1] = new BRepAdaptor_Curve(edge);
+            addEdge(id, i - 1, *entry.curves[i - 1], entry.deflection);
+        }
+
+        pointsDirty = true;
+        return id;
+    }
+
+public:
+    SnapIndex(double lineDeflection)
+        : lineDeflection(lineDeflection)
+    {
+    }
+
+    /// @brief indexes the vertices and edges of the shape and returns its id
+    int insert(const TopoDS_Shape& shape)
+    {
+        size_t firstSegment = segments.size();
+        int id = addShape(shape);
+        addIntersections(firstSegment);
+        return id;
+    }
+
+    /// @brief inserts the shapes as one batch, their intersections are searched together
+    Int32Array insertShapes(const ShapeArray& shapeArray)
+    {
+        size_t firstSegment = segments.size();
+        std::vector<int> ids;
+        for (const auto& shape : vecFromJSArray<TopoDS_Shape>(shapeArray)) {
+            ids.push_back(addShape(shape));
+        }
+        addIntersections(firstSegment);
+        return toTypedArray<Int32Array>(ids);
+    }
+
+    bool remove(int id)
+    {
+        if (shapes.erase(id) == 0) {
+            return false;
+        }
+
+        points.erase(std::remove_if(points.begin(), points.end(),
+                         [&](const KeyPoint& key) { return key.shapeId == id || key.otherShapeId == id; }),
+            points.end());
+        segments.erase(std::remove_if(segments.begin(), segments.end(),
+                           [&](const Segment& segment) { return segment.shapeId == id; }),
+            segments.end());
+        dropSegmentTree();
+        pointsDirty = true;
+        return true;
+    }
+
+    void clear()
+    {
+        shapes.clear();
+        points.clear();
+        segments.clear();
+        dropSegmentTree();
+        pointsDirty = true;
+    }
+
+    int size() const
+    {
+        return static_cast<int>(shapes.size());
+    }
+
+    /// @brief the nearest enabled key point within radius of the point, else the nearest point on a curve
+    SnapResult snapPoint(const Vector3& position, double radius, int types)
+    {
+        ensureTrees();
+        gp_Pnt target = Vector3::toPnt(position);
+        Candidate best;
+        pointTree.query([&](const std::array<double, 6>& box) { return boxDistance(box, target) <= radius; },
+            [&](int index) {
+                const auto& key = points[index];
+                double distance = key.point.Distance(target);
+                if ((types & static_cast<int>(key.type)) && distance <= radius && best.offer(distance, 0)) {
+                    best.result = SnapResult { true, key.type, key.shapeId, key.edgeIndex,
+                        Vector3::fromPnt(key.point), key.parameter, distance };
+                }
+            });
+        if (best.result.found || !(types & static_cast<int>(SnapType::Nearest))) {
+            return best.result;
+        }
+
+        int nearest = -1;
+        double fraction = 0;
+        segmentTree.query([&](const std::array<double, 6>& box) { return boxDistance(box, target) <= radius; },
+            [&](int index) {
+                double t = segmentFraction(segments[index], target);
+                gp_Pnt point = segments[index].start.Translated(gp_Vec(segments[index].start, segments[index].end) * t);
+                double distance = point.Distance(target);
+                if (distance <= radius && best.offer(distance, 0)) {
+                    nearest = index;
+                    fraction = t;
+                }
+            });
+        if (nearest >= 0) {
+            best.result = onCurve(segments[nearest], fraction, target);
+            best.result.distance = Vector3::toPnt(best.result.point).Distance(target);
+        }
+        return best.result;
+    }
+
+    /// @brief like snapPoint for a pick ray: distances are measured to the ray and, between equally close
+    /// candidates, the one nearer to the origin wins
+    SnapResult snapRay(const Vector3& origin, const Vector3& direction, double radius, int types)
+    {
+        ensureTrees();
+        gp_Pnt from = Vector3::toPnt(origin);
+        gp_Dir dir = Vector3::toDir(direction);
+        Candidate best;
+        pointTree.query([&](const std::array<double, 6>& box) { return rayHitsBox(box, from, dir, radius); },
+            [&](int index) {
+                const auto& key = points[index];
+                double depth;
+                double distance = rayDistance(key.point, from, dir, depth);
+                if ((types & static_cast<int>(key.type)) && distance <= radius && best.offer(distance, depth)) {
+                    best.result = SnapResult { true, key.type, key.shapeId, key.edgeIndex,
+                        Vector3::fromPnt(key.point), key.parameter, distance };
+                }
+            });
+        if (best.result.found || !(types & static_cast<int>(SnapType::Nearest))) {
+            return best.result;
+        }
+
+        int nearest = -1;
+        double nearestFraction = 0;
+        segmentTree.query([&](const std::array<double, 6>& box) { return rayHitsBox(box, from, dir, radius); },
+            [&](int index) {
+                double fraction, depth;
+                closestSegmentRay(segments[index], from, dir, fraction, depth);
+                const auto& segment = segments[index];
+                gp_Pnt point = segment.start.Translated(gp_Vec(segment.start, segment.end) * fraction);
+                double distance = point.Distance(from.Translated(gp_Vec(dir) * depth));
+                if (distance <= radius && best.offer(distance, depth)) {
+                    nearest = index;
+                    nearestFraction = fraction;
+                }
+            });
+        if (nearest >= 0) {
+            const auto& segment = segments[nearest];
+            gp_Pnt onSegment = segment.start.Translated(gp_Vec(segment.start, segment.end) * nearestFraction);
+            best.result = onCurve(segment, nearestFraction, onSegment);
+            double depth;
+            best.result.distance = rayDistance(Vector3::toPnt(best.result.point), from, dir, depth);
+        }
+        return best.result;
+    }
+};
+
+EMSCRIPTEN_BINDINGS(Snap)
+{
+    // SnapType：捕捉类型，查询时按位组合作为 types 掩码
+    enum_<SnapType>("SnapType")
+        .value("Endpoint", SnapType::Endpoint)
+        .value("Midpoint", SnapType::Midpoint)
+        .value("Center", SnapType::Center)
+        .value("Intersection", SnapType::Intersection)
+        .value("Nearest", SnapType::Nearest);
+
+    // SnapResult：捕捉结果，found 为 false 时其余字段无意义
+    value_object<SnapResult>("SnapResult")
+        .field("found", &SnapResult::found)
+        .field("type", &SnapResult::type)
+        .field("shapeId", &SnapResult::shapeId)
+        .field("edgeIndex", &SnapResult::edgeIndex)
+        .field("point", &SnapResult::point)
+        .field("parameter", &SnapResult::parameter)
+        .field("distance", &SnapResult::distance);
+
+    // 绑定 SnapIndex 类（持久化的空间捕捉索引：关键点 KD 树 + 曲线线段 BVH）
+    class_<SnapIndex>("SnapIndex")
+        .constructor<double>()
+        // insert(shape) -> number：加入形状的顶点、中点、圆心、交点和离散线段，返回形状 id
+        .function("insert", &SnapIndex::insert)
+        // insertShapes(shapes) -> Int32Array：批量加入形状并一次性求交，返回各形状 id
+        .function("insertShapes", &SnapIndex::insertShapes)
+        // remove(id) -> boolean：移除形状及与其相关的交点
+        .function("remove", &SnapIndex::remove)
+        // clear()：清空索引
+        .function("clear", &SnapIndex::clear)
+        // size() -> number：索引中的形状数量
+        .function("size", &SnapIndex::size)
+        // snapPoint(point, radius, types) -> SnapResult：半径内最近的关键点，没有则为曲线上的最近点
+        .function("snapPoint", &SnapIndex::snapPoint)
+        // snapRay(origin, direction, radius, types) -> SnapResult：拾取射线半径内的最佳捕捉点，距离相同时取离原点近的
+        .function("snapRay", &SnapIndex::snapRay);
+}
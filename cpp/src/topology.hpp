@@ -0,0 +1,199 @@
+// Part of the Chili3d Project, under the AGPL-3.0 License.
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "shared.hpp"
+
+struct TopologyAdjacency {
+    /// @brief count + 1 entries; the neighbours of item i are indices[offsets[i]] .. indices[offsets[i + 1] - 1]
+    Int32Array offsets;
+    Int32Array indices;
+};
+
+/// @brief Indexed sub-shapes of one shape, built once and reused across queries. Sub-shape indices are 0-based
+/// and follow TopExp::MapShapes order, so they match the indices used by findSubShapes, fillet and chamfer.
+/// Ancestor/descendant adjacency is built lazily per type pair and kept in CSR form.
+class TopologyIndex {
+    struct Adjacency {
+        std::vector<int> offsets;
+        std::vector<int> indices;
+    };
+
+    TopoDS_Shape root;
+    std::array<TopTools_IndexedMapOfShape, TopAbs_SHAPE> maps;
+    std::unordered_map<int, Adjacency> adjacencies;
+
+    static bool isValidType(TopAbs_ShapeEnum type)
+    {
+        return type >= TopAbs_COMPOUND && type < TopAbs_SHAPE;
+    }
+
+    void buildAncestors(TopAbs_ShapeEnum from, TopAbs_ShapeEnum to, Adjacency& adjacency) const
+    {
+        TopTools_IndexedDataMapOfShapeListOfShape dataMap;
+        TopExp::MapShapesAndUniqueAncestors(root, from, to, dataMap);
+        for (int i = 1; i <= maps[from].Extent(); i++) {
+            const auto* ancestors = dataMap.Seek(maps[from](i));
+            if (ancestors != nullptr) {
+                for (TopTools_ListIteratorOfListOfShape it(*ancestors); it.More(); it.Next()) {
+                    adjacency.indices.push_back(maps[to].FindIndex(it.Value()) - 1);
+                }
+            }
+            adjacency.offsets.push_back(adjacency.indices.size());
+        }
+    }
+
+    void buildDescendants(TopAbs_ShapeEnum from, TopAbs_ShapeEnum to, Adjacency& adjacency) const
+    {
+        for (int i = 1; i <= maps[from].Extent(); i++) {
+            TopTools_IndexedMapOfShape descendants;
+            TopExp::MapShapes(maps[from](i), to, descendants);
+            for (int j = 1; j <= descendants.Extent(); j++) {
+                adjacency.indices.push_back(maps[to].FindIndex(descendants(j)) - 1);
+            }
+            adjacency.offsets.push_back(adjacency.indices.size());
+        }
+    }
+
+    const Adjacency& adjacency(TopAbs_ShapeEnum from, TopAbs_ShapeEnum to)
+    {
+        int key = from * TopAbs_SHAPE + to;
+        auto it = adjacencies.find(key);
+        if (it != adjacencies.end()) {
+            return it->second;
+        }
+
+        Adjacency& adjacency = adjacencies[key];
+        adjacency.offsets.push_back(0);
+        if (from == to) {
+            for (int i = 0; i < maps[from].Extent(); i++) {
+                adjacency.indices.push_back(i);
+                adjacency.offsets.push_back(i + 1);
+            }
+        } else if (to < from) {
+            buildAncestors(from, to, adjacency);
+        } else {
+            buildDescendants(from, to, adjacency);
+        }
+        return adjacency;
+    }
+
+    std::vector<int> neighbours(const TopoDS_Shape& subShape, TopAbs_ShapeEnum type)
+    {
+        int index = indexOf(subShape);
+        if (index < 0 || !isValidType(type)) {
+            return {};
+        }
+
+        const auto& adjacent = adjacency(subShape.ShapeType(), type);
+        return std::vector<int>(adjacent.indices.begin() + adjacent.offsets[index],
+            adjacent.indices.begin() + adjacent.offsets[index + 1]);
+    }
+
+    static Int32Array toInt32Array(const std::vector<int>& values)
+    {
+        auto view = emscripten::typed_memory_view(values.size(), values.data());
+        return Int32Array(emscripten::val(view).call<emscripten::val>("slice"));
+    }
+
+    ShapeArray toShapeArray(const std::vector<int>& indices, TopAbs_ShapeEnum type) const
+    {
+        std::vector<TopoDS_Shape> shapes;
+        shapes.reserve(indices.size());
+        for (int index : indices) {
+            shapes.push_back(maps[type](index + 1));
+        }
+        return ShapeArray(emscripten::val::array(shapes));
+    }
+
+public:
+    TopologyIndex(const TopoDS_Shape& shape)
+        : root(shape)
+    {
+        for (int type = TopAbs_COMPOUND; type < TopAbs_SHAPE; type++) {
+            TopExp::MapShapes(shape, static_cast<TopAbs_ShapeEnum>(type), maps[type]);
+        }
+    }
+
+    const TopoDS_Shape& shape() const
+    {
+        return root;
+    }
+
+    const TopTools_IndexedMapOfShape& map(TopAbs_ShapeEnum type) const
+    {
+        return maps[type];
+    }
+
+    int count(TopAbs_ShapeEnum type) const
+    {
+        return isValidType(type) ? maps[type].Extent() : 0;
+    }
+
+    /// @brief 0-based index of the sub-shape among sub-shapes of its type (orientation ignored), -1 if absent
+    int indexOf(const TopoDS_Shape& subShape) const
+    {
+        if (subShape.IsNull()) {
+            return -1;
+        }
+        return maps[subShape.ShapeType()].FindIndex(subShape) - 1;
+    }
+
+    TopoDS_Shape subShape(TopAbs_ShapeEnum type, int index) const
+    {
+        if (!isValidType(type) || index < 0 || index >= maps[type].Extent()) {
+            return TopoDS_Shape();
+        }
+        return maps[type](index + 1);
+    }
+
+    ShapeArray subShapes(TopAbs_ShapeEnum type) const
+    {
+        if (!isValidType(type)) {
+            return ShapeArray(emscripten::val::array());
+        }
+        return ShapeArray(emscripten::val::array(maps[type].cbegin(), maps[type].cend()));
+    }
+
+    /// @brief sub-shapes of a higher level type containing subShape, empty when ancestorType is not above it
+    ShapeArray ancestors(const TopoDS_Shape& subShape, TopAbs_ShapeEnum ancestorType)
+    {
+        if (subShape.IsNull() || ancestorType >= subShape.ShapeType()) {
+            return ShapeArray(emscripten::val::array());
+        }
+        return toShapeArray(neighbours(subShape, ancestorType), ancestorType);
+    }
+
+    /// @brief sub-shapes of a lower level type inside subShape, empty when descendantType is not below it
+    ShapeArray descendants(const TopoDS_Shape& subShape, TopAbs_ShapeEnum descendantType)
+    {
+        if (subShape.IsNull() || descendantType <= subShape.ShapeType()) {
+            return ShapeArray(emscripten::val::array());
+        }
+        return toShapeArray(neighbours(subShape, descendantType), descendantType);
+    }
+
+    /// @brief CSR adjacency between all sub-shapes of two types: ancestors when to is a higher level
+    /// (e.g. EDGE -> FACE), descendants otherwise (e.g. FACE -> EDGE)
+    TopologyAdjacency adjacencyArrays(TopAbs_ShapeEnum from, TopAbs_ShapeEnum to)
+    {
+        if (!isValidType(from) || !isValidType(to)) {
+            return TopologyAdjacency { toInt32Array({ 0 }), toInt32Array({}) };
+        }
+
+        const auto& adjacent = adjacency(from, to);
+        return TopologyAdjacency { toInt32Array(adjacent.offsets), toInt32Array(adjacent.indices) };
+    }
+};
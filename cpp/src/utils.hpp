@@ -11,6 +11,8 @@
 
 #include "shared.hpp"
 
+const double ANGLE_DEFLECTION = 0.2;
+
 std::vector<ExtremaCCResult> extremaCCs(const Geom_Curve* curve1, const Geom_Curve* curve2, double maxDistance);
 
 std::optional<ProjectPointResult> projectToCurve(const Geom_Curve* curve, gp_Pnt pnt);
@@ -22,4 +24,11 @@ ProjectPointResult projectOrNearestCP(const Geom_Curve* curve, const gp_Pnt& pnt
 TopTools_SequenceOfShape shapeArrayToSequenceOfShape(const ShapeArray& shapes);
 TopTools_ListOfShape shapeArrayToListOfShape(const ShapeArray& shapes);
 
-double boundingBoxRatio(const TopoDS_Shape& shape, double linearDeflection);
\ No newline at end of file
+double boundingBoxRatio(const TopoDS_Shape& shape, double linearDeflection);
+/// @brief copies the values into a new JS typed array (TArray must match the element type)
+template <typename TArray, typename T>
+TArray toTypedArray(const std::vector<T>& values)
+{
+    auto view = emscripten::typed_memory_view(values.size(), values.data());
+    return TArray(emscripten::val(view).call<emscripten::val>("slice"));
+}
@@ -15,8 +15,26 @@ export interface ShapeNode extends ClassHandle {
     shape: TopoDS_Shape | undefined;
     color: EmbindString | undefined;
     getChildren(): Array<ShapeNode>;
+    getBounds(_0: boolean): BoundsHierarchy;
 }
 
+export type ExportNode = {
+    shape: TopoDS_Shape;
+    name: EmbindString;
+    color: EmbindString;
+    transform: Array<number>;
+};
+
+export type ImportStatistics = {
+    labelCount: number;
+    shapeLookups: number;
+    shapeMisses: number;
+    nameLookups: number;
+    nameConversions: number;
+    colorLookups: number;
+    colorQueries: number;
+};
+
 export interface Converter extends ClassHandle {}
 
 export interface ShapeResult extends ClassHandle {
@@ -28,6 +46,70 @@ export interface ShapeResult extends ClassHandle {
 
 export interface ShapeFactory extends ClassHandle {}
 
+export type BooleanOptions = {
+    parallel: boolean;
+    useOBB: boolean;
+    fuzzyValue: number;
+    glue: BOPAlgo_GlueEnum;
+    nonDestructive: boolean;
+};
+
+export interface CellsBuilder extends ClassHandle {
+    isDone(): boolean;
+    allParts(): ShapeResult;
+    selectUnion(): ShapeResult;
+    selectDifference(): ShapeResult;
+    selectIntersection(): ShapeResult;
+    addToResult(_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>, _2: number): ShapeResult;
+    removeFromResult(_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>): ShapeResult;
+    removeAllFromResult(): ShapeResult;
+    removeInternalBoundaries(): ShapeResult;
+}
+
+export interface PrimitiveTypeValue<T extends number> {
+    value: T;
+}
+export type PrimitiveType =
+    | PrimitiveTypeValue<0>
+    | PrimitiveTypeValue<1>
+    | PrimitiveTypeValue<2>
+    | PrimitiveTypeValue<3>;
+
+export interface FeatureTypeValue<T extends number> {
+    value: T;
+}
+export type FeatureType =
+    | FeatureTypeValue<0>
+    | FeatureTypeValue<1>
+    | FeatureTypeValue<2>
+    | FeatureTypeValue<3>
+    | FeatureTypeValue<4>
+    | FeatureTypeValue<5>
+    | FeatureTypeValue<6>
+    | FeatureTypeValue<7>
+    | FeatureTypeValue<8>
+    | FeatureTypeValue<9>;
+
+export type FeatureStatistics = {
+    evaluations: number;
+    cacheHits: number;
+    lastMilliseconds: number;
+    totalMilliseconds: number;
+};
+
+export interface FeatureGraph extends ClassHandle {
+    addShape(_0: TopoDS_Shape): number;
+    addFeature(_0: FeatureType, _1: Array<number>, _2: Array<number>): number;
+    setShape(_0: number, _1: TopoDS_Shape): boolean;
+    setNumbers(_0: number, _1: Array<number>): boolean;
+    evaluate(_0: number): ShapeResult;
+    isDirty(_0: number): boolean;
+    nodeStatistics(_0: number): FeatureStatistics;
+    totalStatistics(): FeatureStatistics;
+    size(): number;
+    setCacheCapacity(_0: number): void;
+}
+
 export interface Curve extends ClassHandle {}
 
 export type SurfaceBounds = {
@@ -39,6 +121,77 @@ export type SurfaceBounds = {
 
 export interface Surface extends ClassHandle {}
 
+export type SurfaceProjection = {
+    point: Vector3;
+    u: number;
+    v: number;
+    distance: number;
+};
+
+export interface CurveProjector extends ClassHandle {
+    reset(): void;
+    project(_0: Vector3): ProjectPointResult;
+    projectPoints(_0: Float64Array): Float64Array;
+}
+
+export interface SurfaceProjector extends ClassHandle {
+    reset(): void;
+    project(_0: Vector3): SurfaceProjection | undefined;
+    projectPoints(_0: Float64Array): Float64Array;
+}
+
+export type DistanceResult = {
+    pairs: Int32Array;
+    distances: Float64Array;
+    points: Float64Array;
+    overlaps: Uint8Array;
+};
+
+export interface MassPropertyModeValue<T extends number> {
+    value: T;
+}
+export type MassPropertyMode =
+    | MassPropertyModeValue<0>
+    | MassPropertyModeValue<1>;
+
+export type MassProperties = {
+    length: Float64Array;
+    area: Float64Array;
+    volume: Float64Array;
+    centroid: Float64Array;
+    inertia: Float64Array;
+    error: Float64Array;
+};
+
+export interface BoundsKindValue<T extends number> {
+    value: T;
+}
+export type BoundsKind =
+    | BoundsKindValue<0>
+    | BoundsKindValue<1>
+    | BoundsKindValue<2>
+    | BoundsKindValue<3>;
+
+export type BoundsHierarchy = {
+    nodes: Float32Array;
+    stride: number;
+};
+
+export interface Measure extends ClassHandle {}
+
+export type HeapStatistics = {
+    heapSize: number;
+    footprint: number;
+    peakFootprint: number;
+    inUse: number;
+    peakInUse: number;
+    free: number;
+    fragmentation: number;
+    arenaCalls: number;
+};
+
+export interface Memory extends ClassHandle {}
+
 export interface Mesher extends ClassHandle {
     mesh(): MeshData;
     edgesMeshPosition(): Array<number>;
@@ -64,6 +217,14 @@ export interface MeshData extends ClassHandle {
     faceMeshData: FaceMeshData;
 }
 
+export interface ExtrudePreview extends ClassHandle {
+    update(_0: Vector3): boolean;
+    position(): Float32Array;
+    normal(): Float32Array;
+    index(): Uint32Array;
+    segmentCount(): number;
+}
+
 export interface GeomAbs_ShapeValue<T extends number> {
     value: T;
 }
@@ -84,6 +245,14 @@ export type GeomAbs_JoinType =
     | GeomAbs_JoinTypeValue<2>
     | GeomAbs_JoinTypeValue<1>;
 
+export interface BOPAlgo_GlueEnumValue<T extends number> {
+    value: T;
+}
+export type BOPAlgo_GlueEnum =
+    | BOPAlgo_GlueEnumValue<0>
+    | BOPAlgo_GlueEnumValue<1>
+    | BOPAlgo_GlueEnumValue<2>;
+
 export interface TopAbs_ShapeEnumValue<T extends number> {
     value: T;
 }
@@ -511,6 +680,46 @@ export interface Face extends ClassHandle {}
 
 export interface Solid extends ClassHandle {}
 
+export interface HlrCategoryValue<T extends number> {
+    value: T;
+}
+export type HlrCategory =
+    | HlrCategoryValue<0>
+    | HlrCategoryValue<1>
+    | HlrCategoryValue<2>
+    | HlrCategoryValue<3>
+    | HlrCategoryValue<4>
+    | HlrCategoryValue<5>
+    | HlrCategoryValue<6>;
+
+export type HlrResult = {
+    segments: Float32Array;
+    offsets: Int32Array;
+};
+
+export type SliceResult = {
+    points: Float64Array;
+    polylineOffsets: Int32Array;
+    planeOffsets: Int32Array;
+    closed: Uint8Array;
+};
+
+export type TopologyAdjacency = {
+    offsets: Int32Array;
+    indices: Int32Array;
+};
+
+export interface TopologyIndex extends ClassHandle {
+    shape(): TopoDS_Shape;
+    count(_0: TopAbs_ShapeEnum): number;
+    indexOf(_0: TopoDS_Shape): number;
+    subShape(_0: TopAbs_ShapeEnum, _1: number): TopoDS_Shape;
+    subShapes(_0: TopAbs_ShapeEnum): Array<TopoDS_Shape>;
+    ancestors(_0: TopoDS_Shape, _1: TopAbs_ShapeEnum): Array<TopoDS_Shape>;
+    descendants(_0: TopoDS_Shape, _1: TopAbs_ShapeEnum): Array<TopoDS_Shape>;
+    adjacencyArrays(_0: TopAbs_ShapeEnum, _1: TopAbs_ShapeEnum): TopologyAdjacency;
+}
+
 export type Domain = {
     start: number;
     end: number;
@@ -570,6 +779,45 @@ export type ExtremaCCResult = {
     u2: number;
 };
 
+export type EdgeIntersections = {
+    offsets: Int32Array;
+    others: Int32Array;
+    parameters: Float64Array;
+    points: Float64Array;
+};
+
+export interface Sketch extends ClassHandle {}
+
+export interface SnapTypeValue<T extends number> {
+    value: T;
+}
+export type SnapType =
+    | SnapTypeValue<1>
+    | SnapTypeValue<2>
+    | SnapTypeValue<4>
+    | SnapTypeValue<8>
+    | SnapTypeValue<16>;
+
+export type SnapResult = {
+    found: boolean;
+    type: SnapType;
+    shapeId: number;
+    edgeIndex: number;
+    point: Vector3;
+    parameter: number;
+    distance: number;
+};
+
+export interface SnapIndex extends ClassHandle {
+    insert(_0: TopoDS_Shape): number;
+    insertShapes(_0: Array<TopoDS_Shape>): Int32Array;
+    remove(_0: number): boolean;
+    clear(): void;
+    size(): number;
+    snapPoint(_0: Vector3, _1: number, _2: number): SnapResult;
+    snapRay(_0: Vector3, _1: Vector3, _2: number, _3: number): SnapResult;
+}
+
 export interface Transient extends ClassHandle {}
 
 interface EmbindModule {
@@ -582,6 +830,15 @@ interface EmbindModule {
         convertFromStl(_0: Uint8Array): ShapeNode | undefined;
         convertToStep(_0: Array<TopoDS_Shape>): string;
         convertToIges(_0: Array<TopoDS_Shape>): string;
+        lastImportStatistics(): ImportStatistics;
+        contentHash(_0: Uint8Array): string;
+        convertToCache(_0: ShapeNode, _1: EmbindString, _2: number): Uint8Array;
+        convertFromCache(_0: Uint8Array, _1: EmbindString): ShapeNode | undefined;
+        convertNodesToStep(_0: Array<ExportNode>): Uint8Array | undefined;
+        convertNodesToIges(_0: Array<ExportNode>): Uint8Array | undefined;
+        convertNodesToGlb(_0: Array<ExportNode>, _1: number, _2: boolean): Uint8Array;
+        convertToStl(_0: Array<TopoDS_Shape>, _1: number): Uint8Array;
+        convertToStlPerSolid(_0: Array<TopoDS_Shape>, _1: number): Array<Uint8Array>;
     };
     ShapeResult: {};
     ShapeFactory: {
@@ -617,6 +874,40 @@ interface EmbindModule {
         box(_0: Pln, _1: number, _2: number, _3: number): ShapeResult;
         pyramid(_0: Pln, _1: number, _2: number, _3: number): ShapeResult;
         rect(_0: Pln, _1: number, _2: number): ShapeResult;
+        primitivesCompound(_0: Float64Array): ShapeResult;
+        primitives(_0: Float64Array): Array<TopoDS_Shape>;
+        booleanCommonWithOptions(_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>, _2: BooleanOptions): ShapeResult;
+        booleanCutWithOptions(_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>, _2: BooleanOptions): ShapeResult;
+        booleanFuseWithOptions(_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>, _2: BooleanOptions): ShapeResult;
+        linearPattern(_0: TopoDS_Shape, _1: Vector3, _2: number): ShapeResult;
+        circularPattern(_0: TopoDS_Shape, _1: Ax1, _2: number, _3: number): ShapeResult;
+        curvePattern(_0: TopoDS_Shape, _1: TopoDS_Shape, _2: number, _3: boolean): ShapeResult;
+        filletIndexed(_0: TopologyIndex, _1: Array<number>, _2: number): ShapeResult;
+        chamferIndexed(_0: TopologyIndex, _1: Array<number>, _2: number): ShapeResult;
+    };
+    CellsBuilder: {
+        new (_0: Array<TopoDS_Shape>, _1: Array<TopoDS_Shape>, _2: BooleanOptions): CellsBuilder;
+    };
+    PrimitiveType: {
+        Box: PrimitiveTypeValue<0>;
+        Cylinder: PrimitiveTypeValue<1>;
+        Sphere: PrimitiveTypeValue<2>;
+        Cone: PrimitiveTypeValue<3>;
+    };
+    FeatureType: {
+        Shape: FeatureTypeValue<0>;
+        Wire: FeatureTypeValue<1>;
+        Face: FeatureTypeValue<2>;
+        Prism: FeatureTypeValue<3>;
+        Revolve: FeatureTypeValue<4>;
+        Fuse: FeatureTypeValue<5>;
+        Cut: FeatureTypeValue<6>;
+        Common: FeatureTypeValue<7>;
+        Fillet: FeatureTypeValue<8>;
+        Chamfer: FeatureTypeValue<9>;
+    };
+    FeatureGraph: {
+        new (): FeatureGraph;
     };
     Curve: {
         curveLength(_0: Geom_Curve | null): number;
@@ -628,6 +919,7 @@ interface EmbindModule {
         projects(_0: Geom_Curve | null, _1: Vector3): Array<Vector3>;
         projectOrNearest(_0: Geom_Curve | null, _1: Vector3): ProjectPointResult;
         nearestExtremaCC(_0: Geom_Curve | null, _1: Geom_Curve | null): ExtremaCCResult | undefined;
+        evaluate(_0: Geom_Curve | null, _1: Float64Array, _2: number): Float64Array;
     };
     Surface: {
         isPlanar(_0: Geom_Surface | null): boolean;
@@ -636,6 +928,37 @@ interface EmbindModule {
         projectPoint(_0: Geom_Surface | null, _1: Vector3): Array<Vector3>;
         parameters(_0: Geom_Surface | null, _1: Vector3, _2: number): UV | undefined;
         nearestPoint(_0: Geom_Surface | null, _1: Vector3): PointAndParameter | undefined;
+        evaluate(_0: Geom_Surface | null, _1: Float64Array, _2: boolean): Float64Array;
+        evaluateGrid(_0: Geom_Surface | null, _1: SurfaceBounds, _2: number, _3: number, _4: boolean): Float64Array;
+    };
+    CurveProjector: {
+        new (_0: Geom_Curve | null): CurveProjector;
+    };
+    SurfaceProjector: {
+        new (_0: Geom_Surface | null): SurfaceProjector;
+    };
+    MassPropertyMode: {
+        Exact: MassPropertyModeValue<0>;
+        Mesh: MassPropertyModeValue<1>;
+    };
+    BoundsKind: {
+        Group: BoundsKindValue<0>;
+        Shape: BoundsKindValue<1>;
+        Solid: BoundsKindValue<2>;
+        Face: BoundsKindValue<3>;
+    };
+    Measure: {
+        distances(_0: Array<TopoDS_Shape>, _1: number): DistanceResult;
+        properties(_0: Array<TopoDS_Shape>, _1: MassPropertyMode, _2: number, _3: number): MassProperties;
+        bounds(_0: TopoDS_Shape, _1: boolean): BoundsHierarchy;
+    };
+    Memory: {
+        heapInUse(): number;
+        heapStatistics(): HeapStatistics;
+        resetPeak(): void;
+        setArenaMode(_0: boolean): void;
+        isArenaMode(): boolean;
+        diagnostics(_0: Array<TopoDS_Shape>, _1: boolean): string;
     };
     Mesher: {
         new (_0: TopoDS_Shape, _1: number): Mesher;
@@ -643,6 +966,9 @@ interface EmbindModule {
     EdgeMeshData: {};
     FaceMeshData: {};
     MeshData: {};
+    ExtrudePreview: {
+        new (_0: TopoDS_Shape, _1: number): ExtrudePreview;
+    };
     GeomAbs_Shape: {
         GeomAbs_C0: GeomAbs_ShapeValue<0>;
         GeomAbs_C1: GeomAbs_ShapeValue<2>;
@@ -657,6 +983,11 @@ interface EmbindModule {
         GeomAbs_Intersection: GeomAbs_JoinTypeValue<2>;
         GeomAbs_Tangent: GeomAbs_JoinTypeValue<1>;
     };
+    BOPAlgo_GlueEnum: {
+        BOPAlgo_GlueOff: BOPAlgo_GlueEnumValue<0>;
+        BOPAlgo_GlueShift: BOPAlgo_GlueEnumValue<1>;
+        BOPAlgo_GlueFull: BOPAlgo_GlueEnumValue<2>;
+    };
     TopAbs_ShapeEnum: {
         TopAbs_VERTEX: TopAbs_ShapeEnumValue<7>;
         TopAbs_EDGE: TopAbs_ShapeEnumValue<6>;
@@ -789,6 +1120,11 @@ interface EmbindModule {
         removeFeature(_0: TopoDS_Shape, _1: Array<TopoDS_Shape>): TopoDS_Shape;
         removeSubShape(_0: TopoDS_Shape, _1: Array<TopoDS_Shape>): TopoDS_Shape;
         sectionSP(_0: TopoDS_Shape, _1: Pln): TopoDS_Shape;
+        cloneShared(_0: TopoDS_Shape): TopoDS_Shape;
+        findAncestorIndexed(_0: TopologyIndex, _1: TopoDS_Shape, _2: TopAbs_ShapeEnum): Array<TopoDS_Shape>;
+        findSubShapesIndexed(_0: TopologyIndex, _1: TopAbs_ShapeEnum): Array<TopoDS_Shape>;
+        slice(_0: TopoDS_Shape, _1: Vector3, _2: Array<number>, _3: number): SliceResult;
+        hlrPoly(_0: TopoDS_Shape, _1: Array<number>, _2: number): HlrResult;
     };
     Vertex: {
         point(_0: TopoDS_Vertex): Vector3;
@@ -817,6 +1153,32 @@ interface EmbindModule {
     Solid: {
         volume(_0: TopoDS_Solid): number;
     };
+    HlrCategory: {
+        VisibleSharp: HlrCategoryValue<0>;
+        HiddenSharp: HlrCategoryValue<1>;
+        VisibleOutline: HlrCategoryValue<2>;
+        HiddenOutline: HlrCategoryValue<3>;
+        VisibleSmooth: HlrCategoryValue<4>;
+        HiddenSmooth: HlrCategoryValue<5>;
+        Count: HlrCategoryValue<6>;
+    };
+    TopologyIndex: {
+        new (_0: TopoDS_Shape): TopologyIndex;
+    };
+    Sketch: {
+        intersections(_0: Array<TopoDS_Edge>, _1: number): EdgeIntersections;
+        regions(_0: Array<TopoDS_Edge>, _1: number): Array<TopoDS_Face>;
+    };
+    SnapType: {
+        Endpoint: SnapTypeValue<1>;
+        Midpoint: SnapTypeValue<2>;
+        Center: SnapTypeValue<4>;
+        Intersection: SnapTypeValue<8>;
+        Nearest: SnapTypeValue<16>;
+    };
+    SnapIndex: {
+        new (_0: number): SnapIndex;
+    };
     Transient: {
         isKind(_0: Standard_Transient | null, _1: EmbindString): boolean;
         isInstance(_0: Standard_Transient | null, _1: EmbindString): boolean;
@@ -65,6 +65,27 @@ export class OccShape implements IShape {
         return tshape;
     }
 
+    // 只保存弱引用，未 dispose 的形状仍可被垃圾回收，回收后由 FinalizationRegistry 移除
+    static readonly #live = new Set<WeakRef<OccShape>>();
+    static readonly #registry = new FinalizationRegistry((ref: WeakRef<OccShape>) => OccShape.#live.delete(ref));
+
+    /**
+     * 内存诊断：报告 wasm 堆统计与当前存活（未 dispose 且未被回收）的形状数量
+     * @param detailed 为 true 时额外统计按类型分组的存活 Standard_Transient 与每个形状的三角化内存
+     */
+    static memoryDiagnostics(detailed: boolean = false) {
+        let shapes: TopoDS_Shape[] = [];
+        for (const ref of OccShape.#live) {
+            const shape = ref.deref();
+            if (shape === undefined) {
+                OccShape.#live.delete(ref);
+            } else {
+                shapes.push(shape._shape);
+            }
+        }
+        return JSON.parse(wasm.Memory.diagnostics(shapes, detailed));
+    }
+
     readonly shapeType: ShapeType;
     protected _mesh: IShapeMeshData | undefined;
     get mesh(): IShapeMeshData {
@@ -72,6 +93,8 @@ export class OccShape implements IShape {
         return this._mesh;
     }
 
+    readonly #liveRef: WeakRef<OccShape>;
+
     protected _shape: TopoDS_Shape;
     get shape(): TopoDS_Shape {
         return this._shape;
@@ -100,6 +123,9 @@ export class OccShape implements IShape {
         this._id = id ?? Id.generate();
         this._shape = shape;
         this.shapeType = OcctHelper.getShapeType(shape);
+        this.#liveRef = new WeakRef(this);
+        OccShape.#live.add(this.#liveRef);
+        OccShape.#registry.register(this, this.#liveRef, this.#liveRef);
     }
 
     transformed(matrix: Matrix4): IShape {
@@ -251,6 +277,8 @@ export class OccShape implements IShape {
     };
 
     protected disposeInternal(): void {
+        OccShape.#live.delete(this.#liveRef);
+        OccShape.#registry.unregister(this.#liveRef);
         this._shape.nullify();
         this._shape.delete();
         this._shape = null as any;